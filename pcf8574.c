@@ -47,6 +47,20 @@
  *******************************************************************************
  */
 
+/** Count trailing zeros of a non-zero value */
+#if defined(__GNUC__) || defined(__clang__)
+#define PCF8574_CTZ(x) ((uint8_t)__builtin_ctz((unsigned int)(x)))
+#else
+#define PCF8574_CTZ(x) CountTrailingZeros((uint32_t)(x))
+#endif
+
+/** Statistics counters, compiled out without PCF8574_ENABLE_STATS */
+#if PCF8574_ENABLE_STATS
+#define PCF8574_STATS_INC(pstc,field) ((pstc)->stcStats.field++)
+#else
+#define PCF8574_STATS_INC(pstc,field)
+#endif
+
 /**
  *******************************************************************************
  ** Global variable definitions (declared in header file with 'extern') 
@@ -65,9 +79,21 @@
  *******************************************************************************
  */
 
-static stc_pcf8574_list_item_t* pstcPcf8574ListRoot = NULL;
-static volatile boolean_t bLock = FALSE;
-static volatile boolean_t bHandleIrq = FALSE;
+static stc_pcf8574_group_t stcPcf8574DefaultGroup;
+static stc_pcf8574_group_t* pstcPcf8574GroupRoot = &stcPcf8574DefaultGroup;
+static volatile uint32_t u32Pcf8574Ticks = 0;
+static stc_pcf8574_timer_t* apstcPcf8574TimerWheel[PCF8574_TIMER_WHEEL_SIZE];
+static stc_pcf8574_handle_t* pstcPcf8574SeqPending = NULL;
+
+/** Quadrature steps indexed by (previous AB << 2) | AB, PCF8574_QUAD_INVALID if both signals changed */
+#define PCF8574_QUAD_INVALID 2
+static const int8_t ai8QuadTable[16] =
+{
+     0, -1,  1,  PCF8574_QUAD_INVALID,
+     1,  0,  PCF8574_QUAD_INVALID, -1,
+    -1,  PCF8574_QUAD_INVALID,  0,  1,
+     PCF8574_QUAD_INVALID,  1, -1,  0
+};
 
 /**
  *******************************************************************************
@@ -75,6 +101,14 @@ static volatile boolean_t bHandleIrq = FALSE;
  *******************************************************************************
  */
 
+static void ScanStart(stc_pcf8574_group_t* pstcGroup);
+static void ScanItemDone(stc_pcf8574_group_t* pstcGroup);
+static void ScanTimerExpired(stc_pcf8574_timer_t* pstcTimer);
+static void DebounceTimerExpired(stc_pcf8574_timer_t* pstcTimer);
+static void KeypadTimerExpired(stc_pcf8574_timer_t* pstcTimer);
+static void PollTimerExpired(stc_pcf8574_timer_t* pstcTimer);
+static void StormTimerExpired(stc_pcf8574_timer_t* pstcTimer);
+
 /**
  *******************************************************************************
  ** Function implementation - global ('extern') and local ('static') 
@@ -82,364 +116,4064 @@ static volatile boolean_t bHandleIrq = FALSE;
  */
 
 
+#if !defined(__GNUC__) && !defined(__clang__)
 /**
- ** \brief Add item to the linked list
+ ** \brief Count trailing zeros for compilers without builtin
  **
- ** \param pstcListItem Pointer of list item to add
+ ** \param u32Value Non-zero value
  **
+ ** \returns index of the lowest set bit
  */
-static void ListItemAdd(stc_pcf8574_list_item_t* pstcListItem)
+static uint8_t CountTrailingZeros(uint32_t u32Value)
 {
-    stc_pcf8574_list_item_t* pstcCurrent = pstcPcf8574ListRoot;
-    if (pstcPcf8574ListRoot == NULL) 
+    static const uint8_t au8DeBruijn[32] =
     {
-        pstcPcf8574ListRoot = pstcListItem;
-        pstcPcf8574ListRoot->Next = NULL;
-        return;
+        0, 1, 28, 2, 29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4, 8,
+        31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6, 11, 5, 10, 9
+    };
+    return au8DeBruijn[(uint32_t)((u32Value & (0 - u32Value)) * 0x077CB531UL) >> 27];
+}
+#endif
+
+/**
+ ** \brief Port width of a handle in bytes
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \returns bytes per port value between 1..PCF8574_MAX_PORT_BYTES
+ */
+static uint8_t PortBytes(stc_pcf8574_handle_t* pstcHandle)
+{
+    uint8_t u8Bytes = (uint8_t)((pstcHandle->u8PortBits + 7) / 8);
+    if (u8Bytes == 0)
+    {
+        return 1;
     }
-    while(pstcCurrent->Next != NULL)
+    return MIN(u8Bytes,PCF8574_MAX_PORT_BYTES);
+}
+
+/**
+ ** \brief Port width of a handle in bits
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \returns GPIOs of the device
+ */
+static uint8_t PortBits(stc_pcf8574_handle_t* pstcHandle)
+{
+    return (uint8_t)(PortBytes(pstcHandle) * 8);
+}
+
+/**
+ ** \brief Mask of all GPIOs of a handle
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \returns port value with all GPIOs set
+ */
+static pcf8574_port_t PortMask(stc_pcf8574_handle_t* pstcHandle)
+{
+    return (pcf8574_port_t)(((pcf8574_port_t)~(pcf8574_port_t)0) >> ((PCF8574_MAX_PORT_BYTES - PortBytes(pstcHandle)) * 8));
+}
+
+/**
+ ** \brief Decode a port value from bus bytes, first byte is P0..P7
+ **
+ ** \param pu8Data Bus bytes
+ **
+ ** \param u8Bytes Bytes per port value
+ **
+ ** \returns port value
+ */
+static pcf8574_port_t DecodePort(const uint8_t* pu8Data, uint8_t u8Bytes)
+{
+    pcf8574_port_t portValue = 0;
+    while(u8Bytes > 0)
     {
-        pstcCurrent = pstcCurrent->Next;
+        u8Bytes--;
+        portValue = (pcf8574_port_t)((portValue << 8) | pu8Data[u8Bytes]);
     }
-    pstcCurrent->Next = pstcListItem;
-    pstcListItem->Next = NULL;
+    return portValue;
 }
 
 /**
- ** \brief Remove item to the linked list
+ ** \brief Encode a port value into bus bytes, first byte is P0..P7
  **
- ** \param pstcListItem Pointer of list item to remove
+ ** \param portValue Port value
  **
+ ** \param pu8Data Bus bytes
+ **
+ ** \param u8Bytes Bytes per port value
  */
-static void ListItemRemove(stc_pcf8574_list_item_t* pstcListItem)
+static void EncodePort(pcf8574_port_t portValue, uint8_t* pu8Data, uint8_t u8Bytes)
 {
-    stc_pcf8574_list_item_t* pstcCurrent = pstcPcf8574ListRoot;
-    stc_pcf8574_list_item_t* pstcLast = NULL;
-    if (pstcListItem == pstcPcf8574ListRoot)
+    uint8_t i;
+    for(i = 0;i < u8Bytes;i++)
+    {
+        pu8Data[i] = (uint8_t)portValue;
+        portValue = (pcf8574_port_t)(portValue >> 8);
+    }
+}
+
+/**
+ ** \brief Recalculate the rising and falling edge masks of one GPIO
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \param u8Bit Bit between 0..PCF8574_MAX_PORT_BITS - 1
+ */
+static void UpdateEdgeMasks(stc_pcf8574_handle_t* pstcHandle, uint8_t u8Bit)
+{
+    pcf8574_port_t portMask = (pcf8574_port_t)((pcf8574_port_t)1 << u8Bit);
+    en_pcf8574_irq_trigger_t enType = pstcHandle->astcCallbacks[u8Bit].enType;
+    pstcHandle->portRiseMask &= (pcf8574_port_t)~portMask;
+    pstcHandle->portFallMask &= (pcf8574_port_t)~portMask;
+    if (pstcHandle->astcCallbacks[u8Bit].pfnCallback == NULL)
     {
-        pstcPcf8574ListRoot = pstcListItem->Next;
-        pstcListItem->Next = NULL;
         return;
     }
-    while(pstcCurrent != pstcListItem)
+    if ((enType == Pcf8574RisingEdge) || (enType == Pcf8574RisingFallingEdge))
     {
-        pstcLast = pstcCurrent;
-        pstcCurrent = pstcCurrent->Next;
-        if (pstcCurrent == NULL) return;
+        pstcHandle->portRiseMask |= portMask;
     }
-    if (pstcLast != NULL)
+    if ((enType == Pcf8574FallingEdge) || (enType == Pcf8574RisingFallingEdge))
     {
-        pstcLast->Next = pstcCurrent->Next;
-        pstcListItem->Next = NULL;
+        pstcHandle->portFallMask |= portMask;
     }
 }
 
-
 /**
- ** \brief Init PCF8574 handle
+ ** \brief Count a transfer in the statistics of a device
  **
  ** \param pstcHandle Pointer of handle
  **
- ** \param pstcListItemOut Pointer to optional list item to add (will be configured automatically)
+ ** \param bRead TRUE for reads
  **
- ** \returns Ok on success
+ ** \param u32Len Bytes of the transfer
+ **
+ ** \param iResult Result of the transport, 0 on success
  */
-en_result_t Pcf8574_Init(stc_pcf8574_handle_t* pstcHandle, stc_pcf8574_list_item_t* pstcListItemOut)
+static void StatsTransfer(stc_pcf8574_handle_t* pstcHandle, boolean_t bRead, uint32_t u32Len, int iResult)
 {
-    if (pstcHandle == NULL)
+#if PCF8574_ENABLE_STATS
+    stc_pcf8574_stats_t* pstcStats = &pstcHandle->stcStats;
+    if (bRead)
     {
-        return ErrorUninitialized;
+        pstcStats->u32Reads++;
+        if (iResult == 0)
+        {
+            pstcStats->u32BytesRead += u32Len;
+        } else
+        {
+            pstcStats->u32ReadErrors++;
+        }
+    } else
+    {
+        pstcStats->u32Writes++;
+        if (iResult == 0)
+        {
+            pstcStats->u32BytesWritten += u32Len;
+        } else
+        {
+            pstcStats->u32WriteErrors++;
+        }
     }
-    if (pstcListItemOut != NULL)
+#else
+    (void)pstcHandle;
+    (void)bRead;
+    (void)u32Len;
+    (void)iResult;
+#endif
+}
+
+#if PCF8574_ENABLE_STATS
+/**
+ ** \brief Add an ISR duration to a log2 histogram
+ **
+ ** \param pstcStats Pointer of statistics
+ **
+ ** \param u32Start PCF8574_STATS_TIMESTAMP() at the start of the ISR
+ */
+static void StatsIsrDuration(stc_pcf8574_stats_t* pstcStats, uint32_t u32Start)
+{
+    uint32_t u32Duration = (uint32_t)PCF8574_STATS_TIMESTAMP() - u32Start;
+    uint8_t u8Bin = 0;
+    while((u32Duration != 0) && (u8Bin < (PCF8574_STATS_HISTOGRAM_BINS - 1)))
     {
-        pstcListItemOut->Handle = pstcHandle;
-        pstcListItemOut->enType = Pcf8574ListTypeNone;
-        ListItemAdd(pstcListItemOut);
+        u32Duration >>= 1;
+        u8Bin++;
     }
-    pstcHandle->pfnRead(pstcHandle->pI2cHandle,pstcHandle->u32Address,&pstcHandle->u8CurrentValues,1);
-    return Ok;
+    pstcStats->au32IsrHistogram[u8Bin]++;
 }
+#endif
 
 /**
- ** \brief Deinit PCF8574 handle
+ ** \brief Call the callbacks for rising and falling GPIOs
+ **
+ ** Only GPIOs which have fired and have a matching callback are visited.
  **
  ** \param pstcHandle Pointer of handle
  **
- ** \param pstcListItemOut Pointer to optional list item to add (will be configured automatically)
+ ** \param portRise GPIOs with rising edge
  **
- ** \returns Ok on success
+ ** \param portFall GPIOs with falling edge
  */
-en_result_t Pcf8574_Deinit(stc_pcf8574_handle_t* pstcHandle, stc_pcf8574_list_item_t* pstcListItemOut)
+static void DispatchEdges(stc_pcf8574_handle_t* pstcHandle, pcf8574_port_t portRise, pcf8574_port_t portFall)
 {
-    if (pstcHandle == NULL)
+    pcf8574_port_t portFired = (pcf8574_port_t)((portRise & pstcHandle->portRiseMask) | (portFall & pstcHandle->portFallMask));
+    uint8_t u8Bit;
+    while(portFired != 0)
     {
-        return ErrorUninitialized;
+        u8Bit = PCF8574_CTZ(portFired);
+        portFired &= (pcf8574_port_t)(portFired - 1);
+        pstcHandle->astcCallbacks[u8Bit].pfnCallback(pstcHandle,u8Bit);
+        PCF8574_STATS_INC(pstcHandle,u32Callbacks);
     }
-    if (pstcListItemOut != NULL)
+    if ((pstcHandle->pfnPortCallback != NULL) && ((portRise | portFall) != 0))
     {
-        pstcListItemOut->Handle = pstcHandle;
-        ListItemRemove(pstcListItemOut);
+        pstcHandle->pfnPortCallback(pstcHandle,portRise,portFall);
+        PCF8574_STATS_INC(pstcHandle,u32Callbacks);
     }
-    return Ok;
 }
 
 /**
- ** \brief Init callback for a specific GPIO
+ ** \brief Filter burst samples into one port value
  **
- ** \param pstcHandle Pointer of handle
+ ** \param pu8Samples Samples in order of reception (bus bytes)
  **
- ** \param u8Bit Bit to address  between 0..7
+ ** \param u8Count Number of samples
  **
- ** \param enType IRQ type, can be Pcf8574RisingEdge, Pcf8574FallingEdge, Pcf8574RisingFallingEdge
+ ** \param u8Bytes Bytes per sample
  **
- ** \param pfnCallback Callback of type pfn_pcf8574_callback_t, example: void Pcf8574Callback(void* pHandle, uint8_t u8Pin);
+ ** \param enFilter Filter to apply
  **
- ** \returns Ok on success
+ ** \param portPrevious Previous port value, kept for undecided bits
+ **
+ ** \returns filtered port value
  */
-en_result_t Pcf8574_InitCallback(stc_pcf8574_handle_t* pstcHandle, uint8_t u8Bit, en_pcf8574_irq_trigger_t enType, pfn_pcf8574_callback_t pfnCallback)
+static pcf8574_port_t FilterSamples(const uint8_t* pu8Samples, uint8_t u8Count, uint8_t u8Bytes, en_pcf8574_filter_t enFilter, pcf8574_port_t portPrevious)
 {
-    if (pstcHandle == NULL)
+    pcf8574_port_t aportSamples[PCF8574_MAX_BURST_SAMPLES];
+    pcf8574_port_t portAnd = (pcf8574_port_t)~(pcf8574_port_t)0;
+    pcf8574_port_t portOr = 0;
+    pcf8574_port_t portResult = 0;
+    pcf8574_port_t portBit;
+    uint8_t u8Ones;
+    int i, j;
+    for(j = 0;j < u8Count;j++)
     {
-        return ErrorUninitialized;
+        aportSamples[j] = DecodePort(&pu8Samples[j * u8Bytes],u8Bytes);
     }
-    if (pfnCallback == NULL)
+    switch(enFilter)
     {
-        return ErrorUninitialized;
+        case Pcf8574FilterMajority:
+            for(i = 0;i < (u8Bytes * 8);i++)
+            {
+                portBit = (pcf8574_port_t)((pcf8574_port_t)1 << i);
+                u8Ones = 0;
+                for(j = 0;j < u8Count;j++)
+                {
+                    u8Ones += ((aportSamples[j] & portBit) != 0) ? 1 : 0;
+                }
+                if ((2 * u8Ones > u8Count) || ((2 * u8Ones == u8Count) && (portPrevious & portBit)))
+                {
+                    portResult |= portBit;
+                }
+            }
+            return portResult;
+        case Pcf8574FilterConsecutive:
+            for(j = 0;j < u8Count;j++)
+            {
+                portAnd &= aportSamples[j];
+                portOr |= aportSamples[j];
+            }
+            return (pcf8574_port_t)(portAnd | (portPrevious & (portAnd ^ portOr)));
+        default:
+            return aportSamples[u8Count - 1];
     }
-    if (u8Bit > 7)
+}
+
+/**
+ ** \brief Number of samples read per IRQ handling
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \returns samples between 1..PCF8574_MAX_BURST_SAMPLES
+ */
+static uint8_t SampleCount(stc_pcf8574_handle_t* pstcHandle)
+{
+    if (pstcHandle->u8BurstSamples == 0)
     {
-        return ErrorInvalidParameter;
+        return 1;
     }
-    pstcHandle->astcCallbacks[u8Bit].enType = enType;
-    pstcHandle->astcCallbacks[u8Bit].pfnCallback = pfnCallback;
-    return Ok;
+    return MIN(pstcHandle->u8BurstSamples,PCF8574_MAX_BURST_SAMPLES);
 }
 
 /**
- ** \brief Deinit callback for a specific GPIO
+ ** \brief Filter the samples of a finished read and store the port value
  **
  ** \param pstcHandle Pointer of handle
  **
- ** \param u8Bit Bit to address  between 0..7
+ ** \param pu8Samples Read data
  **
- ** \returns Ok on success
+ ** \param u8Samples Number of samples between 1..PCF8574_MAX_BURST_SAMPLES
+ **
+ ** \param enFilter Filter to apply
+ **
+ ** \param iResult Result of the transfer, 0 on success
+ **
+ ** \returns port value (also stored as portCurrentValues), the last value if the transfer failed
  */
-en_result_t Pcf8574_DeinitCallback(stc_pcf8574_handle_t* pstcHandle, uint8_t u8Bit)
+static pcf8574_port_t StoreSamples(stc_pcf8574_handle_t* pstcHandle, const uint8_t* pu8Samples, uint8_t u8Samples, en_pcf8574_filter_t enFilter, int iResult)
 {
-    if (pstcHandle == NULL)
-    {
-        return ErrorUninitialized;
-    }
-    if (u8Bit > 7)
+    uint8_t u8Bytes = PortBytes(pstcHandle);
+    StatsTransfer(pstcHandle,TRUE,(uint32_t)u8Samples * u8Bytes,iResult);
+    if (iResult != 0)
     {
-        return ErrorInvalidParameter;
+        return pstcHandle->portCurrentValues;
     }
-    pstcHandle->astcCallbacks[u8Bit].enType = Pcf8574IrqNone;
-    pstcHandle->astcCallbacks[u8Bit].pfnCallback = NULL;
-    return Ok;
+    pstcHandle->portCurrentValues = FilterSamples(pu8Samples,u8Samples,u8Bytes,enFilter,pstcHandle->portCurrentValues);
+    return pstcHandle->portCurrentValues;
 }
 
+/**
+ ** \brief Publish the shadow of a device (seqlock writer)
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \param portValue Port value
+ **
+ ** \param u32Epoch IRQ epoch of the group before the value was read
+ **
+ ** \param bValid FALSE to invalidate the shadow
+ */
+static void ShadowPublish(stc_pcf8574_handle_t* pstcHandle, pcf8574_port_t portValue, uint32_t u32Epoch, boolean_t bValid)
+{
+    PCF8574_ENTER_CRITICAL();
+    pstcHandle->u32ShadowSeq++;
+    PCF8574_MEMORY_BARRIER();
+    pstcHandle->portShadow = portValue;
+    pstcHandle->u32ShadowEpoch = u32Epoch;
+    pstcHandle->bShadowValid = bValid;
+    PCF8574_MEMORY_BARRIER();
+    pstcHandle->u32ShadowSeq++;
+    PCF8574_EXIT_CRITICAL();
+}
 
 /**
- ** \brief Read from PCF8574 handle
+ ** \brief Read the shadow of a device without locks (seqlock reader)
  **
  ** \param pstcHandle Pointer of handle
  **
- ** \returns 8-bit (byte) with the read GPIOs
+ ** \param pportValue Port value of the shadow
+ **
+ ** \param pu32Epoch IRQ epoch of the shadow
+ **
+ ** \returns TRUE if the shadow is valid
  */
-uint8_t Pcf8574_Read(stc_pcf8574_handle_t* pstcHandle)
+static boolean_t ShadowLoad(stc_pcf8574_handle_t* pstcHandle, pcf8574_port_t* pportValue, uint32_t* pu32Epoch)
 {
-    uint8_t u8Tmp;
-    if (pstcHandle == NULL)
+    uint32_t u32Seq;
+    boolean_t bValid;
+    do
     {
-        return 0;
-    }
-    pstcHandle->pfnRead(pstcHandle->pI2cHandle,pstcHandle->u32Address,&u8Tmp,1);
-    pstcHandle->u8CurrentValues = u8Tmp;
-    return u8Tmp;
+        u32Seq = pstcHandle->u32ShadowSeq;
+        PCF8574_MEMORY_BARRIER();
+        *pportValue = pstcHandle->portShadow;
+        *pu32Epoch = pstcHandle->u32ShadowEpoch;
+        bValid = pstcHandle->bShadowValid;
+        PCF8574_MEMORY_BARRIER();
+    } while(((u32Seq & 1) != 0) || (u32Seq != pstcHandle->u32ShadowSeq));
+    return bValid;
 }
 
 /**
- ** \brief Write to PCF8574 handle
+ ** \brief Invalidate the shadow of a device after a write
  **
  ** \param pstcHandle Pointer of handle
- **
- ** \param u8Value Write 8-bit (byte) to GPIOs
  */
-void Pcf8574_Write(stc_pcf8574_handle_t* pstcHandle, uint8_t u8Value)
+static void ShadowInvalidate(stc_pcf8574_handle_t* pstcHandle)
 {
-    if (pstcHandle == NULL)
+    if (pstcHandle->pstcCacheGroup != NULL)
     {
-        return;
+        ShadowPublish(pstcHandle,pstcHandle->portShadow,pstcHandle->u32ShadowEpoch,FALSE);
     }
-    pstcHandle->pfnWrite(pstcHandle->pI2cHandle,pstcHandle->u32Address,&u8Value,1);
 }
 
-
 /**
- ** \brief Init PCF8574 handle
+ ** \brief Read the port with one transfer and filter the samples
  **
  ** \param pstcHandle Pointer of handle
  **
- ** \param pstcListItemOut Pointer to optional list item to add (will be configured automatically)
+ ** \param u8Samples Number of samples between 1..PCF8574_MAX_BURST_SAMPLES
  **
- ** \returns Ok on success
+ ** \param enFilter Filter to apply
+ **
+ ** \returns port value (also stored as portCurrentValues), the last value if the transfer failed
  */
-en_result_t Pcf8574_InitRotaryEncoder(stc_pcf8574_rotaryencoder_t* pstcHandle, stc_pcf8574_list_item_t* pstcListItemOut)
+static pcf8574_port_t ReadSamples(stc_pcf8574_handle_t* pstcHandle, uint8_t u8Samples, en_pcf8574_filter_t enFilter)
 {
-    Pcf8574_Init(pstcHandle->pHandle,NULL);
-    if (pstcListItemOut != NULL)
-    {
-        pstcListItemOut->Handle = pstcHandle;
-        pstcListItemOut->enType = Pcf8574ListTypeEncoder;
-        ListItemAdd(pstcListItemOut);
-    }
-    pstcHandle->pHandle->u8CurrentValues |= (1 << pstcHandle->A) | (1 << pstcHandle->B);
-    Pcf8574_Write(pstcHandle->pHandle,pstcHandle->pHandle->u8CurrentValues);
-    Pcf8574_Read(pstcHandle->pHandle);
+    uint8_t au8Samples[PCF8574_MAX_BURST_SAMPLES * PCF8574_MAX_PORT_BYTES];
+    int iResult = pstcHandle->pfnRead(pstcHandle->pI2cHandle,pstcHandle->u32Address,au8Samples,(uint32_t)u8Samples * PortBytes(pstcHandle));
+    return StoreSamples(pstcHandle,au8Samples,u8Samples,enFilter,iResult);
 }
 
+/**
+ ** \brief Read the port as configured for IRQ handling (single or burst read)
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \returns port value, filtered if burst reading is configured (also stored as portCurrentValues),
+ **          the last value if the transfer failed
+ */
+static pcf8574_port_t ReadPort(stc_pcf8574_handle_t* pstcHandle)
+{
+    return ReadSamples(pstcHandle,SampleCount(pstcHandle),pstcHandle->enBurstFilter);
+}
 
 /**
- ** \brief Execute IRQ handling caused by INT pin for a specific device
+ ** \brief Check if two devices can be read in one vectored transfer
  **
- ** \param pstcHandle Handle
+ ** \param pstcFirst First device of the batch
+ **
+ ** \param pstcHandle Device to add
+ **
+ ** \returns TRUE if both use the same vectored transport
  */
-void Pcf8574_ExecuteIrqHandle(stc_pcf8574_handle_t* pstcHandle)
+static boolean_t SameTransport(stc_pcf8574_handle_t* pstcFirst, stc_pcf8574_handle_t* pstcHandle)
 {
-    uint8_t u8Tmp;
-    uint8_t u8Changes;
-    int i;
-    if (pstcHandle == NULL)
-    {
-        return;
-    }
-    pstcHandle->pfnRead(pstcHandle->pI2cHandle,pstcHandle->u32Address,&u8Tmp,1);
-    u8Changes = pstcHandle->u8CurrentValues ^ u8Tmp;
-    pstcHandle->u8CurrentValues = u8Tmp;
-    for(i = 0;i < 8;i++)
-    {
-        if (((1 << i) & u8Changes) != 0)
-        {
-            if (pstcHandle->astcCallbacks[i].pfnCallback != NULL)
-            {
-                if (pstcHandle->astcCallbacks[i].enType == Pcf8574RisingFallingEdge)
-                {
-                    pstcHandle->astcCallbacks[i].pfnCallback(pstcHandle,i);
-                } else if ((((1 << i) & u8Changes) != 0) && 
-                    (((1 << i) & u8Tmp) != 0) &&
-                    (pstcHandle->astcCallbacks[i].enType == Pcf8574RisingEdge))
-                {
-                    pstcHandle->astcCallbacks[i].pfnCallback(pstcHandle,i);
-                } else if ((((1 << i) & u8Changes) != 0) && 
-                    (((1 << i) & u8Tmp) == 0) &&
-                    (pstcHandle->astcCallbacks[i].enType == Pcf8574FallingEdge))
-                {
-                    pstcHandle->astcCallbacks[i].pfnCallback(pstcHandle,i);
-                }
-            }
-        }
-    }
+    return (boolean_t)((pstcFirst->pfnTransfer != NULL) && (pstcFirst->pfnTransfer == pstcHandle->pfnTransfer) &&
+                       (pstcFirst->pI2cHandle == pstcHandle->pI2cHandle));
 }
 
 /**
- ** \brief Process type rotary encoder handle
+ ** \brief Read the ports of several devices, in one vectored transfer if all use the same transport
  **
- ** \param pstcHandle Handle
+ ** \param ppstcDevices Devices, at most PCF8574_TRANSFER_MAX_MSGS
+ **
+ ** \param u32Count Number of devices
+ **
+ ** \param bIrq TRUE = read as configured for IRQ handling (burst), FALSE = single sample
+ **
+ ** \param pu32Errors Incremented for every failed device
+ **
+ ** \returns transactions used
  */
-void Pcf8574_HandleRotaryEncoder(stc_pcf8574_rotaryencoder_t* pstcHandle)
+static uint32_t ReadBatch(stc_pcf8574_handle_t** ppstcDevices, uint32_t u32Count, boolean_t bIrq, uint32_t* pu32Errors)
 {
-    uint8_t u8Tmp,u8Changed;
-    pstcHandle->pHandle->pfnRead(pstcHandle->pHandle->pI2cHandle,pstcHandle->pHandle->u32Address,&u8Tmp,1);
-    u8Changed = pstcHandle->u8OldData ^ u8Tmp;
-    pstcHandle->u8OldData = u8Tmp;
-    if ((u8Changed & (1 << pstcHandle->Btn)) && ((u8Tmp & (1 << pstcHandle->Btn)) == 0))
+    stc_pcf8574_i2c_msg_t astcMsgs[PCF8574_TRANSFER_MAX_MSGS];
+    uint8_t au8Data[PCF8574_TRANSFER_MAX_MSGS][PCF8574_MAX_BURST_SAMPLES * PCF8574_MAX_PORT_BYTES];
+    uint8_t au8Samples[PCF8574_TRANSFER_MAX_MSGS];
+    boolean_t bVectored = (boolean_t)(u32Count > 1);
+    int iResult = 0;
+    uint32_t i;
+    for(i = 0;i < u32Count;i++)
     {
-        pstcHandle->bButtonClicked = TRUE;
-        pstcHandle->bButton = FALSE;
-    } else if ((u8Changed & (1 << pstcHandle->Btn)) && ((u8Tmp & (1 << pstcHandle->Btn)) != 0))
+        au8Samples[i] = bIrq ? SampleCount(ppstcDevices[i]) : 1;
+        astcMsgs[i].u32Address = ppstcDevices[i]->u32Address;
+        astcMsgs[i].u16Flags = PCF8574_I2C_M_RD;
+        astcMsgs[i].u16Len = (uint16_t)(au8Samples[i] * PortBytes(ppstcDevices[i]));
+        astcMsgs[i].pu8Data = au8Data[i];
+        if (!SameTransport(ppstcDevices[0],ppstcDevices[i]))
+        {
+            bVectored = FALSE;
+        }
+    }
+    if (bVectored)
     {
-        pstcHandle->bButtonClicked = FALSE;
-        pstcHandle->u32LastPressedTime = 0;
-        pstcHandle->bButton = TRUE;
+        iResult = ppstcDevices[0]->pfnTransfer(ppstcDevices[0]->pI2cHandle,astcMsgs,u32Count);
     }
-
-    if ((u8Changed & (1 << pstcHandle->A)) && ((u8Tmp & (1 << pstcHandle->A)) == 0))
+    for(i = 0;i < u32Count;i++)
     {
-        if (u8Tmp & (1 << pstcHandle->B))
+        if (!bVectored)
         {
-            pstcHandle->Counter++;
-        } else
+            iResult = ppstcDevices[i]->pfnRead(ppstcDevices[i]->pI2cHandle,astcMsgs[i].u32Address,astcMsgs[i].pu8Data,astcMsgs[i].u16Len);
+        }
+        StoreSamples(ppstcDevices[i],au8Data[i],au8Samples[i],bIrq ? ppstcDevices[i]->enBurstFilter : Pcf8574FilterNone,iResult);
+        if (iResult != 0)
         {
-            pstcHandle->Counter--;
+            (*pu32Errors)++;
         }
     }
+    return bVectored ? 1 : u32Count;
 }
 
 /**
- ** \brief Execute IRQ handling caused by INT pin for all devices in the list
+ ** \brief Length of the next chunk of a stream write
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \param u32Remain Bytes left to write
+ **
+ ** \returns bytes of the next transfer, a multiple of the port width
  */
-void Pcf8574_ExtIrqHandle(void)
+static uint32_t ChunkLen(stc_pcf8574_handle_t* pstcHandle, uint32_t u32Remain)
 {
-    stc_pcf8574_list_item_t* pstcCurrent = pstcPcf8574ListRoot;
-    if (pstcPcf8574ListRoot == NULL) return;
-    bHandleIrq = TRUE;
-    if (bLock == FALSE)
+    uint32_t u32Max = pstcHandle->u32MaxTransferLen;
+    if ((u32Max == 0) || (u32Remain <= u32Max))
     {
-        bHandleIrq = FALSE;
-        while(pstcCurrent != NULL)
-        {
-            if (pstcCurrent->enType == Pcf8574ListTypeNone)
-            {
-                Pcf8574_ExecuteIrqHandle(pstcCurrent->Handle);
-            }
-            if (pstcCurrent->enType == Pcf8574ListTypeEncoder)
-            {
-                Pcf8574_HandleRotaryEncoder(pstcCurrent->Handle);
-            }
-            pstcCurrent = pstcCurrent->Next;
-        }
+        return u32Remain;
     }
+    u32Max -= u32Max % PortBytes(pstcHandle);
+    return (u32Max == 0) ? PortBytes(pstcHandle) : u32Max;
 }
 
 /**
- ** \brief Lock interrupt handling
+ ** \brief Record an event in the ring buffer of a group (producer side)
+ **
+ ** Transfer completions of several buses may record events of the same
+ ** group, these producers are serialized by PCF8574_ENTER_CRITICAL().
+ **
+ ** \param pstcGroup Pointer of group
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \param portRise GPIOs with rising edge
+ **
+ ** \param portFall GPIOs with falling edge
  */
-void Pcf8574_LockIrq(void)
+static void EventPush(stc_pcf8574_group_t* pstcGroup, stc_pcf8574_handle_t* pstcHandle, pcf8574_port_t portRise, pcf8574_port_t portFall)
 {
-    bLock = TRUE;
+    uint32_t u32Head;
+    stc_pcf8574_event_t* pstcEvent;
+    PCF8574_ENTER_CRITICAL();
+    u32Head = pstcGroup->u32EventHead;
+    if ((u32Head - pstcGroup->u32EventTail) >= pstcGroup->u32EventSize)
+    {
+        pstcGroup->u32EventOverflows++;
+        PCF8574_STATS_INC(pstcGroup,u32Overflows);
+        PCF8574_EXIT_CRITICAL();
+        return;
+    }
+    pstcEvent = &pstcGroup->pastcEvents[u32Head & (pstcGroup->u32EventSize - 1)];
+    pstcEvent->pHandle = pstcHandle;
+    pstcEvent->portRiseMask = portRise;
+    pstcEvent->portFallMask = portFall;
+    pstcEvent->u32Timestamp = u32Pcf8574Ticks;
+    PCF8574_MEMORY_BARRIER();
+    pstcGroup->u32EventHead = u32Head + 1;
+    PCF8574_EXIT_CRITICAL();
 }
 
 /**
- ** \brief Unlock interrupt handling
+ ** \brief Dispatch or record the edges between two port values of a device of a group
+ **
+ ** \param pstcGroup Pointer of group, NULL = callbacks are called directly
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \param portPrevious Port value before
+ **
+ ** \param portTmp Port value now
  */
-void Pcf8574_UnlockIrq(void)
+static void DeliverEdges(stc_pcf8574_group_t* pstcGroup, stc_pcf8574_handle_t* pstcHandle, pcf8574_port_t portPrevious, pcf8574_port_t portTmp)
 {
-    bLock = FALSE;
-    if (bHandleIrq)
+    pcf8574_port_t portChanges = portPrevious ^ portTmp;
+    if ((pstcGroup == NULL) || (pstcGroup->pastcEvents == NULL))
     {
-        Pcf8574_ExtIrqHandle();
+        DispatchEdges(pstcHandle,(pcf8574_port_t)(portChanges & portTmp),(pcf8574_port_t)(portChanges & ~portTmp));
+    } else if (portChanges != 0)
+    {
+        EventPush(pstcGroup,pstcHandle,(pcf8574_port_t)(portChanges & portTmp),(pcf8574_port_t)(portChanges & ~portTmp));
     }
 }
 
 /**
- ** \brief Called every ms for example via SysStick IRQ
+ ** \brief Handle a new sampled port value of a device of a group
+ **
+ ** Debounced devices only keep the sample, the edges are delivered by DebounceTick().
+ **
+ ** \param pstcGroup Pointer of group
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \param portPrevious Port value before
+ **
+ ** \param portTmp Port value now
+ */
+static void ApplyPortValue(stc_pcf8574_group_t* pstcGroup, stc_pcf8574_handle_t* pstcHandle, pcf8574_port_t portPrevious, pcf8574_port_t portTmp)
+{
+    if (!pstcHandle->bDebounce)
+    {
+        DeliverEdges(pstcGroup,pstcHandle,portPrevious,portTmp);
+    } else if ((!pstcHandle->stcDebounceTimer.bActive) && (portTmp != pstcHandle->portDebounced))
+    {
+        Pcf8574_TimerStart(&pstcHandle->stcDebounceTimer,1,DebounceTimerExpired,pstcHandle,pstcGroup);
+    }
+}
+
+/**
+ ** \brief Debounce one device by one tick, the timer is re-armed until all GPIOs are settled
+ **
+ ** Every GPIO has a 2-bit counter, stored bit-sliced in portDebounceCnt0 and
+ ** portDebounceCnt1, so all GPIOs of the port are handled by a few bitwise
+ ** operations. A GPIO toggles its debounced state after its sampled value
+ ** differed for 4 consecutive ticks, any tick agreeing resets the counter.
+ **
+ ** \param pstcTimer Debounce timer of the device, pUser is the group
+ */
+static void DebounceTimerExpired(stc_pcf8574_timer_t* pstcTimer)
+{
+    stc_pcf8574_handle_t* pstcHandle = pstcTimer->pHandle;
+    pcf8574_port_t portPrevious = pstcHandle->portDebounced;
+    pcf8574_port_t portDelta = (pcf8574_port_t)(portPrevious ^ pstcHandle->portCurrentValues);
+    if (!pstcHandle->bDebounce)
+    {
+        return;
+    }
+    pstcHandle->portDebounceCnt0 = (pcf8574_port_t)~(pstcHandle->portDebounceCnt0 & portDelta);
+    pstcHandle->portDebounceCnt1 = (pcf8574_port_t)(pstcHandle->portDebounceCnt0 ^ (pstcHandle->portDebounceCnt1 & portDelta));
+    portDelta &= (pcf8574_port_t)(pstcHandle->portDebounceCnt0 & pstcHandle->portDebounceCnt1);
+    if (portDelta != 0)
+    {
+        pstcHandle->portDebounced ^= portDelta;
+        DeliverEdges(pstcTimer->pUser,pstcHandle,portPrevious,pstcHandle->portDebounced);
+    }
+    if (pstcHandle->portDebounced != pstcHandle->portCurrentValues)
+    {
+        Pcf8574_TimerStart(pstcTimer,1,DebounceTimerExpired,pstcHandle,pstcTimer->pUser);
+    }
+}
+
+/**
+ ** \brief Quadrature state of a rotary encoder, A as bit 1 and B as bit 0
+ **
+ ** \param pstcHandle Rotary encoder handle
+ **
+ ** \param portTmp Port value
+ **
+ ** \returns state 0..3
+ */
+static uint8_t QuadState(stc_pcf8574_rotaryencoder_t* pstcHandle, pcf8574_port_t portTmp)
+{
+    return (uint8_t)((((portTmp >> pstcHandle->A) & 1) << 1) | ((portTmp >> pstcHandle->B) & 1));
+}
+
+/**
+ ** \brief Reset velocity and acceleration of a rotary encoder without steps
+ **
+ ** \param pstcTimer Idle timer of the encoder
+ */
+static void EncoderIdleExpired(stc_pcf8574_timer_t* pstcTimer)
+{
+    stc_pcf8574_rotaryencoder_t* pstcHandle = pstcTimer->pHandle;
+    pstcHandle->i32Velocity = 0;
+    pstcHandle->i32Acceleration = 0;
+}
+
+/**
+ ** \brief Count the time a rotary encoder button is held, re-armed every ms while held
+ **
+ ** \param pstcTimer Button timer of the encoder
+ */
+static void EncoderButtonExpired(stc_pcf8574_timer_t* pstcTimer)
+{
+    stc_pcf8574_rotaryencoder_t* pstcHandle = pstcTimer->pHandle;
+    if (pstcHandle->bButton)
+    {
+        pstcHandle->u32LastPressedTime++;
+        Pcf8574_TimerStart(pstcTimer,1,EncoderButtonExpired,pstcHandle,NULL);
+    }
+}
+
+/**
+ ** \brief Count one step of a rotary encoder and update velocity and acceleration
+ **
+ ** \param pstcHandle Rotary encoder handle
+ **
+ ** \param i8Direction 1 or -1
+ */
+static void EncoderStep(stc_pcf8574_rotaryencoder_t* pstcHandle, int8_t i8Direction)
+{
+    uint32_t u32Now = u32Pcf8574Ticks;
+    uint32_t u32Delta = u32Now - pstcHandle->u32LastStepTime;
+    int32_t i32Velocity;
+    int32_t i32Step = 1;
+    if (u32Delta == 0)
+    {
+        u32Delta = 1;
+    }
+    i32Velocity = (int32_t)(1000 / u32Delta) * i8Direction;
+    if ((pstcHandle->i32Velocity == 0) || ((pstcHandle->i32Velocity > 0) != (i32Velocity > 0)))
+    {
+        pstcHandle->i32Acceleration = 0;
+    } else
+    {
+        pstcHandle->i32Acceleration = (i32Velocity - pstcHandle->i32Velocity) * 1000 / (int32_t)u32Delta;
+    }
+    pstcHandle->i32Velocity = i32Velocity;
+    pstcHandle->u32LastStepTime = u32Now;
+    Pcf8574_TimerStart(&pstcHandle->stcIdleTimer,PCF8574_ENCODER_IDLE_MS + 1,EncoderIdleExpired,pstcHandle,NULL);
+    if (pstcHandle->u16ScaleVelocity != 0)
+    {
+        i32Step += ((i32Velocity < 0) ? -i32Velocity : i32Velocity) / pstcHandle->u16ScaleVelocity;
+        if ((pstcHandle->u8ScaleMax != 0) && (i32Step > pstcHandle->u8ScaleMax))
+        {
+            i32Step = pstcHandle->u8ScaleMax;
+        }
+    }
+    pstcHandle->Counter += i32Step * i8Direction;
+}
+
+/**
+ ** \brief Decode A and B of a rotary encoder with the quadrature transition table
+ **
+ ** Transitions changing both signals are rejected and counted in u32QuadErrors.
+ ** In 2x mode only transitions of A are counted.
+ **
+ ** \param pstcHandle Rotary encoder handle
+ **
+ ** \param portTmp Port value
+ */
+static void DecodeQuadrature(stc_pcf8574_rotaryencoder_t* pstcHandle, pcf8574_port_t portTmp)
+{
+    uint8_t u8State = QuadState(pstcHandle,portTmp);
+    uint8_t u8Index = (uint8_t)((pstcHandle->u8QuadState << 2) | u8State);
+    int8_t i8Step = ai8QuadTable[u8Index];
+    pstcHandle->u8QuadState = u8State;
+    if (i8Step == PCF8574_QUAD_INVALID)
+    {
+        pstcHandle->u32QuadErrors++;
+        return;
+    }
+    if ((i8Step == 0) || ((pstcHandle->enQuadMode == Pcf8574Quad2x) && (((u8Index ^ (u8Index >> 2)) & 0x02) == 0)))
+    {
+        return;
+    }
+    EncoderStep(pstcHandle,i8Step);
+}
+
+/**
+ ** \brief Process a new port value of a rotary encoder
+ **
+ ** \param pstcHandle Rotary encoder handle
+ **
+ ** \param portTmp Port value
+ */
+static void ProcessRotaryEncoder(stc_pcf8574_rotaryencoder_t* pstcHandle, pcf8574_port_t portTmp)
+{
+    pcf8574_port_t portChanged;
+    portChanged = pstcHandle->portOldData ^ portTmp;
+    pstcHandle->portOldData = portTmp;
+    if ((portChanged & (1 << pstcHandle->Btn)) && ((portTmp & (1 << pstcHandle->Btn)) == 0))
+    {
+        pstcHandle->bButtonClicked = TRUE;
+        pstcHandle->bButton = FALSE;
+    } else if ((portChanged & (1 << pstcHandle->Btn)) && ((portTmp & (1 << pstcHandle->Btn)) != 0))
+    {
+        pstcHandle->bButtonClicked = FALSE;
+        pstcHandle->u32LastPressedTime = 0;
+        pstcHandle->bButton = TRUE;
+        Pcf8574_TimerStart(&pstcHandle->stcButtonTimer,1,EncoderButtonExpired,pstcHandle,NULL);
+    }
+
+    if (pstcHandle->enQuadMode != Pcf8574Quad1x)
+    {
+        DecodeQuadrature(pstcHandle,portTmp);
+    } else if ((portChanged & (1 << pstcHandle->A)) && ((portTmp & (1 << pstcHandle->A)) == 0))
+    {
+        if (portTmp & (1 << pstcHandle->B))
+        {
+            EncoderStep(pstcHandle,1);
+        } else
+        {
+            EncoderStep(pstcHandle,-1);
+        }
+    }
+}
+
+/**
+ ** \brief Number of set bits
+ **
+ ** \param u32Value Value
+ **
+ ** \returns set bits
+ */
+static uint8_t BitCount(uint32_t u32Value)
+{
+    uint8_t u8Count = 0;
+    for(;u32Value != 0;u32Value &= u32Value - 1)
+    {
+        u8Count++;
+    }
+    return u8Count;
+}
+
+/**
+ ** \brief Key bits of all crossings of rows and columns
+ **
+ ** \param pstcHandle Keypad handle
+ **
+ ** \param portRows Row GPIOs
+ **
+ ** \param portCols Column GPIOs
+ **
+ ** \returns key bits, bit = row * columns + column
+ */
+static uint32_t KeypadKeys(stc_pcf8574_keypad_t* pstcHandle, pcf8574_port_t portRows, pcf8574_port_t portCols)
+{
+    uint8_t u8Cols = BitCount(pstcHandle->portCols);
+    uint32_t u32ColBits = 0;
+    uint32_t u32Keys = 0;
+    pcf8574_port_t portBit;
+    for(;portCols != 0;portCols &= (pcf8574_port_t)(portCols - 1))
+    {
+        portBit = (pcf8574_port_t)(portCols & (0 - portCols));
+        u32ColBits |= 1UL << BitCount((uint32_t)(pstcHandle->portCols & (portBit - 1)));
+    }
+    for(;portRows != 0;portRows &= (pcf8574_port_t)(portRows - 1))
+    {
+        portBit = (pcf8574_port_t)(portRows & (0 - portRows));
+        u32Keys |= u32ColBits << (BitCount((uint32_t)(pstcHandle->portRows & (portBit - 1))) * u8Cols);
+    }
+    return u32Keys;
+}
+
+/**
+ ** \brief Check a key matrix for ghosting
+ **
+ ** Two rows sharing two or more columns form a rectangle, one of its
+ ** keys can be a ghost of the other three.
+ **
+ ** \param pstcHandle Keypad handle
+ **
+ ** \param u32Matrix Key bits of the scan
+ **
+ ** \returns TRUE if the matrix is ambiguous
+ */
+static boolean_t KeypadGhosting(stc_pcf8574_keypad_t* pstcHandle, uint32_t u32Matrix)
+{
+    uint8_t u8Cols = BitCount(pstcHandle->portCols);
+    uint8_t u8Rows = BitCount(pstcHandle->portRows);
+    uint32_t u32ColMask = (u8Cols >= 32) ? 0xFFFFFFFFUL : ((1UL << u8Cols) - 1);
+    uint32_t au32Rows[32];    //multi-key rows seen so far, rows * columns <= 32
+    uint8_t u8Seen = 0;
+    uint32_t u32Row;
+    uint8_t i;
+    uint8_t j;
+    for(i = 0;i < u8Rows;i++)
+    {
+        u32Row = (u32Matrix >> (i * u8Cols)) & u32ColMask;
+        if (BitCount(u32Row) >= 2)
+        {
+            for(j = 0;j < u8Seen;j++)
+            {
+                if (BitCount(au32Rows[j] & u32Row) >= 2)
+                {
+                    return TRUE;
+                }
+            }
+            au32Rows[u8Seen++] = u32Row;
+        }
+    }
+    return FALSE;
+}
+
+/**
+ ** \brief Scan the key matrix of a keypad, report changed keys and return to idle
+ **
+ ** The active rows are known from the idle state (columns low). With the
+ ** rows driven low instead, one read returns the active columns. A single
+ ** active row or column identifies the keys directly, otherwise only the
+ ** active columns are scanned one by one. While keys are held the matrix
+ ** is rescanned every PCF8574_KEYPAD_RESCAN_MS, as more keys pressed or
+ ** released in an already active row change no GPIO and raise no INT.
+ ** Each drive state must be read back before the next one is written, so
+ ** the scan cannot be merged into one Pcf8574_WriteStream() transaction.
+ **
+ ** \param pstcHandle Keypad handle
+ **
+ ** \param pstcGroup Group of the keypad
+ */
+static void KeypadScan(stc_pcf8574_keypad_t* pstcHandle, stc_pcf8574_group_t* pstcGroup)
+{
+    stc_pcf8574_handle_t* pstcDevice = pstcHandle->pHandle;
+    pcf8574_port_t portBase = (pcf8574_port_t)(pstcDevice->portStagedValues & ~(pstcHandle->portRows | pstcHandle->portCols));
+    pcf8574_port_t portIdle = (pcf8574_port_t)(portBase | pstcHandle->portRows);
+    pcf8574_port_t portRowsActive;
+    pcf8574_port_t portColsActive;
+    pcf8574_port_t portCol;
+    uint32_t u32Matrix = 0;
+    uint32_t u32Keys;
+    uint32_t u32Changed;
+    uint8_t u8Key;
+    pstcHandle->u32Scans++;
+    portRowsActive = (pcf8574_port_t)(pstcHandle->portRows & ~Pcf8574_Read(pstcDevice));
+    if (portRowsActive != 0)
+    {
+        Pcf8574_Write(pstcDevice,(pcf8574_port_t)(portBase | pstcHandle->portCols));
+        portColsActive = (pcf8574_port_t)(pstcHandle->portCols & ~Pcf8574_Read(pstcDevice));
+        if ((BitCount(portRowsActive) == 1) || (BitCount(portColsActive) == 1))
+        {
+            u32Matrix = KeypadKeys(pstcHandle,portRowsActive,portColsActive);
+        } else
+        {
+            for(portCol = portColsActive;portCol != 0;portCol &= (pcf8574_port_t)(portCol - 1))
+            {
+                Pcf8574_Write(pstcDevice,(pcf8574_port_t)(portIdle | (pstcHandle->portCols & ~(portCol & (0 - portCol)))));
+                u32Matrix |= KeypadKeys(pstcHandle,(pcf8574_port_t)(pstcHandle->portRows & ~Pcf8574_Read(pstcDevice)),(pcf8574_port_t)(portCol & (0 - portCol)));
+            }
+        }
+        Pcf8574_Write(pstcDevice,portIdle);
+        Pcf8574_Read(pstcDevice);    //INT reference is the idle state
+    }
+    u32Keys = u32Matrix;
+    if (KeypadGhosting(pstcHandle,u32Matrix))
+    {
+        pstcHandle->u32Ghosts++;
+        u32Keys &= pstcHandle->u32Keys;
+    }
+    u32Changed = u32Keys ^ pstcHandle->u32Keys;
+    pstcHandle->u32Keys = u32Keys;
+    while(u32Changed != 0)
+    {
+        u8Key = PCF8574_CTZ(u32Changed);
+        u32Changed &= u32Changed - 1;
+        if (pstcHandle->pfnCallback != NULL)
+        {
+            pstcHandle->pfnCallback(pstcHandle,u8Key,(boolean_t)((u32Keys >> u8Key) & 1));
+        }
+    }
+    if (pstcHandle->u32Keys != 0)
+    {
+        Pcf8574_TimerStart(&pstcHandle->stcScanTimer,PCF8574_KEYPAD_RESCAN_MS,KeypadTimerExpired,pstcHandle,pstcGroup);
+    }
+}
+
+/**
+ ** \brief Scan delay or rescan interval of a keypad expired, deferred while the group is locked
+ **
+ ** \param pstcTimer Scan timer of the keypad, pUser is the group
+ */
+static void KeypadTimerExpired(stc_pcf8574_timer_t* pstcTimer)
+{
+    stc_pcf8574_group_t* pstcGroup = pstcTimer->pUser;
+    if (pstcGroup->bLock)
+    {
+        Pcf8574_TimerStart(pstcTimer,1,KeypadTimerExpired,pstcTimer->pHandle,pstcGroup);
+        return;
+    }
+    KeypadScan(pstcTimer->pHandle,pstcGroup);
+}
+
+/**
+ ** \brief Process IRQ of type keypad handle
+ **
+ ** \param pstcHandle Keypad handle
+ **
+ ** \param pstcGroup Group of the keypad
+ **
+ ** \param portTmp Port value sampled by the IRQ handling
+ */
+static void ProcessKeypad(stc_pcf8574_keypad_t* pstcHandle, stc_pcf8574_group_t* pstcGroup, pcf8574_port_t portTmp)
+{
+    if (((pstcHandle->portRows & ~portTmp) == 0) && (pstcHandle->u32Keys == 0))
+    {
+        return;
+    }
+#if PCF8574_KEYPAD_DEBOUNCE_MS == 0
+    KeypadScan(pstcHandle,pstcGroup);
+#else
+    if (!pstcHandle->stcScanTimer.bActive)
+    {
+        Pcf8574_TimerStart(&pstcHandle->stcScanTimer,PCF8574_KEYPAD_DEBOUNCE_MS,KeypadTimerExpired,pstcHandle,pstcGroup);
+    }
+#endif
+}
+
+/**
+ ** \brief Set the GPIO of a sequencer on or off, the device is written at the end of the ms tick
+ **
+ ** \param pstcSeq Sequencer
+ **
+ ** \param bOn TRUE to switch on
+ */
+static void SeqSetLevel(stc_pcf8574_seq_t* pstcSeq, boolean_t bOn)
+{
+    stc_pcf8574_handle_t* pstcHandle = pstcSeq->pHandle;
+    pcf8574_port_t portBit = (pcf8574_port_t)((pcf8574_port_t)1 << pstcSeq->u8Pin);
+    pstcSeq->bOn = bOn;
+    PCF8574_ENTER_CRITICAL();
+    if ((bOn != FALSE) != (pstcSeq->bActiveLow != FALSE))
+    {
+        pstcHandle->portStagedValues |= portBit;
+    } else
+    {
+        pstcHandle->portStagedValues &= (pcf8574_port_t)~portBit;
+    }
+    if (!pstcHandle->bSeqPending)
+    {
+        pstcHandle->bSeqPending = TRUE;
+        pstcHandle->pstcSeqNext = pstcPcf8574SeqPending;
+        pstcPcf8574SeqPending = pstcHandle;
+    }
+    PCF8574_EXIT_CRITICAL();
+}
+
+/**
+ ** \brief Sequencer timer expired, next phase of the pattern
+ **
+ ** \param pstcTimer Timer of the sequencer
+ */
+static void SeqTimerExpired(stc_pcf8574_timer_t* pstcTimer)
+{
+    stc_pcf8574_seq_t* pstcSeq = pstcTimer->pHandle;
+    if (!pstcSeq->bOn)
+    {
+        SeqSetLevel(pstcSeq,TRUE);
+        Pcf8574_TimerStart(pstcTimer,pstcSeq->u32OnMs,SeqTimerExpired,pstcSeq,NULL);
+        return;
+    }
+    SeqSetLevel(pstcSeq,FALSE);
+    if ((pstcSeq->u32Remain != 0) && (--pstcSeq->u32Remain == 0))
+    {
+        return;
+    }
+    Pcf8574_TimerStart(pstcTimer,pstcSeq->u32OffMs,SeqTimerExpired,pstcSeq,NULL);
+}
+
+/**
+ ** \brief Write all devices with pending sequencer changes, one transfer per device
+ **
+ ** Devices with an async write in progress stay pending for the next tick.
+ ** A sequencer is not bound to a group, so all devices stay pending while
+ ** any group is locked by the application.
+ */
+static void SeqFlush(void)
+{
+    stc_pcf8574_handle_t* pstcHandle;
+    stc_pcf8574_handle_t* pstcBusy = NULL;
+    stc_pcf8574_group_t* pstcGroup;
+    for(pstcGroup = pstcPcf8574GroupRoot;pstcGroup != NULL;pstcGroup = pstcGroup->Next)
+    {
+        if (pstcGroup->bLock)
+        {
+            return;
+        }
+    }
+    for(;;)
+    {
+        PCF8574_ENTER_CRITICAL();
+        pstcHandle = pstcPcf8574SeqPending;
+        if (pstcHandle != NULL)
+        {
+            pstcPcf8574SeqPending = pstcHandle->pstcSeqNext;
+            pstcHandle->pstcSeqNext = NULL;
+            pstcHandle->bSeqPending = FALSE;
+        }
+        PCF8574_EXIT_CRITICAL();
+        if (pstcHandle == NULL)
+        {
+            break;
+        }
+        if (pstcHandle->pstcBus == NULL)
+        {
+            Pcf8574_Flush(pstcHandle);
+        } else if (Pcf8574_FlushAsync(pstcHandle,NULL) == ErrorOperationInProgress)
+        {
+            pstcHandle->bSeqPending = TRUE;
+            pstcHandle->pstcSeqNext = pstcBusy;
+            pstcBusy = pstcHandle;
+        }
+    }
+    while(pstcBusy != NULL)
+    {
+        pstcHandle = pstcBusy;
+        pstcBusy = pstcHandle->pstcSeqNext;
+        PCF8574_ENTER_CRITICAL();
+        pstcHandle->pstcSeqNext = pstcPcf8574SeqPending;
+        pstcPcf8574SeqPending = pstcHandle;
+        PCF8574_EXIT_CRITICAL();
+    }
+}
+
+/**
+ ** \brief Remove a device from the pending sequencer changes
+ **
+ ** \param pstcHandle Pointer of handle
+ */
+static void SeqRemove(stc_pcf8574_handle_t* pstcHandle)
+{
+    stc_pcf8574_handle_t** ppstcCurrent;
+    PCF8574_ENTER_CRITICAL();
+    for(ppstcCurrent = &pstcPcf8574SeqPending;*ppstcCurrent != NULL;ppstcCurrent = &((*ppstcCurrent)->pstcSeqNext))
+    {
+        if (*ppstcCurrent == pstcHandle)
+        {
+            *ppstcCurrent = pstcHandle->pstcSeqNext;
+            break;
+        }
+    }
+    pstcHandle->pstcSeqNext = NULL;
+    pstcHandle->bSeqPending = FALSE;
+    PCF8574_EXIT_CRITICAL();
+}
+
+/**
+ ** \brief Get the device handle of a list item
+ **
+ ** \param pstcItem Pointer of list item
+ **
+ ** \returns device handle
+ */
+static stc_pcf8574_handle_t* ItemDevice(stc_pcf8574_list_item_t* pstcItem)
+{
+    if (pstcItem->enType == Pcf8574ListTypeEncoder)
+    {
+        return ((stc_pcf8574_rotaryencoder_t*)pstcItem->Handle)->pHandle;
+    }
+    if (pstcItem->enType == Pcf8574ListTypeKeypad)
+    {
+        return ((stc_pcf8574_keypad_t*)pstcItem->Handle)->pHandle;
+    }
+    return (stc_pcf8574_handle_t*)pstcItem->Handle;
+}
+
+/**
+ ** \brief Process a new port value of a list item
+ **
+ ** \param pstcItem Pointer of list item
+ **
+ ** \param portPrevious Port value before
+ **
+ ** \param portTmp Port value now
+ */
+static void ProcessItem(stc_pcf8574_list_item_t* pstcItem, pcf8574_port_t portPrevious, pcf8574_port_t portTmp)
+{
+    stc_pcf8574_group_t* pstcGroup = pstcItem->pGroup;
+#if PCF8574_ENABLE_STATS
+    stc_pcf8574_handle_t* pstcDevice = ItemDevice(pstcItem);
+#endif
+    if ((pstcItem->u32MaxLatencyMs != 0) && ((u32Pcf8574Ticks - pstcGroup->u32ScanTick) > pstcItem->u32MaxLatencyMs))
+    {
+        pstcItem->u32DeadlineMisses++;
+        pstcGroup->u32DeadlineMisses++;
+    }
+    if (portPrevious != portTmp)
+    {
+        pstcGroup->u32StormActivity++;
+    }
+#if PCF8574_ENABLE_STATS
+    pstcDevice->stcStats.u32Irqs++;
+    if (portPrevious == portTmp)
+    {
+        pstcDevice->stcStats.u32Spurious++;
+    } else
+    {
+        pstcGroup->bScanChanged = TRUE;
+    }
+#endif
+    if (pstcItem->enType == Pcf8574ListTypeNone)
+    {
+        ApplyPortValue(pstcItem->pGroup,pstcItem->Handle,portPrevious,portTmp);
+    }
+    if (pstcItem->enType == Pcf8574ListTypeEncoder)
+    {
+        ProcessRotaryEncoder(pstcItem->Handle,portTmp);
+    }
+    if (pstcItem->enType == Pcf8574ListTypeKeypad)
+    {
+        ProcessKeypad(pstcItem->Handle,pstcItem->pGroup,portTmp);
+    }
+}
+
+/**
+ ** \brief Sample the device of a list item with a blocking read and process it
+ **
+ ** \param pstcItem Pointer of list item
+ **
+ ** \param pstcDevice Device of the list item
+ */
+static void ServiceItem(stc_pcf8574_list_item_t* pstcItem, stc_pcf8574_handle_t* pstcDevice)
+{
+    pcf8574_port_t portPrevious = pstcDevice->portCurrentValues;
+#if PCF8574_ENABLE_STATS
+    uint32_t u32Start = (uint32_t)PCF8574_STATS_TIMESTAMP();
+#endif
+    ProcessItem(pstcItem,portPrevious,ReadPort(pstcDevice));
+#if PCF8574_ENABLE_STATS
+    StatsIsrDuration(&pstcDevice->stcStats,u32Start);
+#endif
+}
+
+/**
+ ** \brief Sample the devices of several list items and process them
+ **
+ ** Devices with the same vectored transport are read in one transaction,
+ ** the items are processed afterwards in the given order.
+ **
+ ** \param ppstcItems List items
+ **
+ ** \param ppstcDevices Devices of the list items
+ **
+ ** \param u32Count Number of list items, at most PCF8574_TRANSFER_MAX_MSGS
+ */
+static void ServiceBatch(stc_pcf8574_list_item_t** ppstcItems, stc_pcf8574_handle_t** ppstcDevices, uint32_t u32Count)
+{
+    pcf8574_port_t aportPrevious[PCF8574_TRANSFER_MAX_MSGS];
+    uint32_t u32Errors = 0;
+    uint32_t i;
+#if PCF8574_ENABLE_STATS
+    uint32_t u32Start = (uint32_t)PCF8574_STATS_TIMESTAMP();
+#endif
+    if (u32Count <= 1)
+    {
+        if (u32Count == 1)
+        {
+            ServiceItem(ppstcItems[0],ppstcDevices[0]);
+        }
+        return;
+    }
+    for(i = 0;i < u32Count;i++)
+    {
+        aportPrevious[i] = ppstcDevices[i]->portCurrentValues;
+    }
+    ReadBatch(ppstcDevices,u32Count,TRUE,&u32Errors);
+    for(i = 0;i < u32Count;i++)
+    {
+        ProcessItem(ppstcItems[i],aportPrevious[i],ppstcDevices[i]->portCurrentValues);
+#if PCF8574_ENABLE_STATS
+        StatsIsrDuration(&ppstcDevices[i]->stcStats,u32Start);
+#endif
+    }
+}
+
+/**
+ ** \brief Add a device to the batch of Pcf8574_ReadAll(), the batch is read when full or the transport changes
+ **
+ ** \param apstcDevices Batch of devices
+ **
+ ** \param pu32Batch Devices in the batch
+ **
+ ** \param pstcDevice Device to add, NULL to read the rest of the batch
+ **
+ ** \param paportValues Port values of the image
+ **
+ ** \param pu32Done Entries of paportValues already read
+ **
+ ** \param pstcSnapshot Snapshot information
+ */
+static void SnapshotAdd(stc_pcf8574_handle_t** apstcDevices, uint32_t* pu32Batch, stc_pcf8574_handle_t* pstcDevice, pcf8574_port_t* paportValues, uint32_t* pu32Done, stc_pcf8574_snapshot_t* pstcSnapshot)
+{
+    uint32_t i;
+    if ((*pu32Batch > 0) && ((pstcDevice == NULL) || (*pu32Batch == PCF8574_TRANSFER_MAX_MSGS) || !SameTransport(apstcDevices[0],pstcDevice)))
+    {
+        pstcSnapshot->u32Transfers += ReadBatch(apstcDevices,*pu32Batch,FALSE,&pstcSnapshot->u32Errors);
+        for(i = 0;i < *pu32Batch;i++)
+        {
+            paportValues[(*pu32Done)++] = apstcDevices[i]->portCurrentValues;
+        }
+        *pu32Batch = 0;
+    }
+    if (pstcDevice != NULL)
+    {
+        apstcDevices[(*pu32Batch)++] = pstcDevice;
+    }
+}
+
+/**
+ ** \brief Queue a transfer at a bus and start it if the bus is idle
+ **
+ ** \param pstcBus Pointer of bus
+ **
+ ** \param pstcXfer Pointer of transfer
+ */
+static void BusSubmit(stc_pcf8574_bus_t* pstcBus, stc_pcf8574_xfer_t* pstcXfer)
+{
+    boolean_t bStart = FALSE;
+    int iResult;
+    pstcXfer->pBus = pstcBus;
+    pstcXfer->Next = NULL;
+    PCF8574_ENTER_CRITICAL();
+    if (pstcBus->pstcTail == NULL)
+    {
+        pstcBus->pstcHead = pstcXfer;
+        bStart = TRUE;
+    } else
+    {
+        pstcBus->pstcTail->Next = pstcXfer;
+    }
+    pstcBus->pstcTail = pstcXfer;
+    PCF8574_EXIT_CRITICAL();
+    if (bStart)
+    {
+        iResult = pstcBus->pfnSubmit(pstcBus->pI2cHandle,pstcXfer);
+        if (iResult != 0)
+        {
+            Pcf8574_XferComplete(pstcXfer,iResult);
+        }
+    }
+}
+
+/**
+ ** \brief Completion of an async read transfer
+ **
+ ** \param pstcXfer Pointer of transfer
+ **
+ ** \param iResult Result of the transport, 0 on success
+ */
+static void ReadXferDone(stc_pcf8574_xfer_t* pstcXfer, int iResult)
+{
+    stc_pcf8574_handle_t* pstcHandle = pstcXfer->pHandle;
+    stc_pcf8574_list_item_t* pstcItem;
+    pfn_pcf8574_done_t pfnDone;
+    pcf8574_port_t portPrevious = pstcHandle->portCurrentValues;
+    StatsTransfer(pstcHandle,TRUE,pstcXfer->u32Len,iResult);
+    if (iResult == 0)
+    {
+        pstcHandle->portCurrentValues = FilterSamples(pstcHandle->au8ReadData,(uint8_t)(pstcXfer->u32Len / PortBytes(pstcHandle)),PortBytes(pstcHandle),pstcHandle->enBurstFilter,portPrevious);
+    }
+    PCF8574_ENTER_CRITICAL();
+    pstcItem = pstcXfer->pUser;
+    pfnDone = pstcHandle->pfnReadDone;
+    pstcXfer->pUser = NULL;
+    pstcHandle->pfnReadDone = NULL;
+    pstcXfer->bBusy = FALSE;
+    PCF8574_EXIT_CRITICAL();
+    pstcHandle->portPollPrevious = (pstcItem != NULL) ? pstcHandle->portCurrentValues : portPrevious;
+    if ((pstcItem != NULL) && (iResult == 0))
+    {
+        ProcessItem(pstcItem,portPrevious,pstcHandle->portCurrentValues);
+    }
+    if (pfnDone != NULL)
+    {
+        pfnDone(pstcHandle,(iResult == 0) ? Ok : Error);
+    }
+    if (pstcItem != NULL)
+    {
+        ScanItemDone(pstcItem->pGroup);
+    }
+}
+
+/**
+ ** \brief Start an async read or join a read already in progress
+ **
+ ** A scan and a user read can share one transfer, each of them only once.
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \param pstcItem List item for IRQ scans, NULL for user reads
+ **
+ ** \param pfnDone Done callback of user reads
+ **
+ ** \returns Ok if the read was started or joined
+ */
+static en_result_t StartRead(stc_pcf8574_handle_t* pstcHandle, stc_pcf8574_list_item_t* pstcItem, pfn_pcf8574_done_t pfnDone)
+{
+    stc_pcf8574_xfer_t* pstcXfer = &pstcHandle->stcXferRead;
+    en_result_t enResult = Ok;
+    boolean_t bStart = FALSE;
+    PCF8574_ENTER_CRITICAL();
+    if (pstcXfer->bBusy == FALSE)
+    {
+        pstcXfer->bBusy = TRUE;
+        pstcXfer->pUser = pstcItem;
+        pstcHandle->pfnReadDone = pfnDone;
+        bStart = TRUE;
+    } else if ((pstcItem != NULL) && (pstcXfer->pUser == NULL))
+    {
+        pstcXfer->pUser = pstcItem;
+    } else if ((pstcItem == NULL) && (pstcHandle->pfnReadDone == NULL) && (pfnDone != NULL))
+    {
+        pstcHandle->pfnReadDone = pfnDone;
+    } else
+    {
+        enResult = ErrorOperationInProgress;
+    }
+    PCF8574_EXIT_CRITICAL();
+    if (bStart)
+    {
+        pstcXfer->enDir = Pcf8574XferRead;
+        pstcXfer->u32Address = pstcHandle->u32Address;
+        pstcXfer->pu8Data = pstcHandle->au8ReadData;
+        pstcXfer->u32Len = (uint32_t)SampleCount(pstcHandle) * PortBytes(pstcHandle);
+        pstcXfer->pfnDone = ReadXferDone;
+        pstcXfer->pHandle = pstcHandle;
+        BusSubmit(pstcHandle->pstcBus,pstcXfer);
+    }
+    return enResult;
+}
+
+/**
+ ** \brief Submit the next chunk of an async write
+ **
+ ** \param pstcHandle Pointer of handle
+ */
+static void WriteNextChunk(stc_pcf8574_handle_t* pstcHandle)
+{
+    stc_pcf8574_xfer_t* pstcXfer = &pstcHandle->stcXferWrite;
+    uint32_t u32Chunk = ChunkLen(pstcHandle,pstcHandle->u32StreamRemain);
+    pstcXfer->pu8Data = (uint8_t*)pstcHandle->pu8StreamNext;
+    pstcXfer->u32Len = u32Chunk;
+    pstcHandle->pu8StreamNext += u32Chunk;
+    pstcHandle->u32StreamRemain -= u32Chunk;
+    BusSubmit(pstcHandle->pstcBus,pstcXfer);
+}
+
+/**
+ ** \brief Completion of an async write transfer
+ **
+ ** \param pstcXfer Pointer of transfer
+ **
+ ** \param iResult Result of the transport, 0 on success
+ */
+static void WriteXferDone(stc_pcf8574_xfer_t* pstcXfer, int iResult)
+{
+    stc_pcf8574_handle_t* pstcHandle = pstcXfer->pHandle;
+    pfn_pcf8574_done_t pfnDone;
+    StatsTransfer(pstcHandle,FALSE,pstcXfer->u32Len,iResult);
+    ShadowInvalidate(pstcHandle);
+    if ((iResult == 0) && (pstcHandle->u32StreamRemain > 0))
+    {
+        WriteNextChunk(pstcHandle);
+        return;
+    }
+    pstcHandle->u32StreamRemain = 0;
+    if (iResult == 0)
+    {
+        pstcHandle->portOutputValues = DecodePort(&pstcXfer->pu8Data[pstcXfer->u32Len - PortBytes(pstcHandle)],PortBytes(pstcHandle));
+        pstcHandle->bOutputValid = TRUE;
+    } else
+    {
+        pstcHandle->bOutputValid = FALSE;
+    }
+    pfnDone = pstcHandle->pfnWriteDone;
+    pstcHandle->pfnWriteDone = NULL;
+    pstcXfer->bBusy = FALSE;
+    if (pfnDone != NULL)
+    {
+        pfnDone(pstcHandle,(iResult == 0) ? Ok : Error);
+    }
+}
+
+/**
+ ** \brief Start an async write of a sequence
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \param pu8Sequence Data, must stay valid until done
+ **
+ ** \param u32Len Number of bytes, a multiple of the port width
+ **
+ ** \param pfnDone Done callback or NULL
+ **
+ ** \param pUser Group of a group flush, NULL otherwise
+ **
+ ** \returns Ok if the write was started
+ */
+static en_result_t StartWrite(stc_pcf8574_handle_t* pstcHandle, const uint8_t* pu8Sequence, uint32_t u32Len, pfn_pcf8574_done_t pfnDone, void* pUser)
+{
+    stc_pcf8574_xfer_t* pstcXfer = &pstcHandle->stcXferWrite;
+    PCF8574_ENTER_CRITICAL();
+    if (pstcXfer->bBusy)
+    {
+        PCF8574_EXIT_CRITICAL();
+        return ErrorOperationInProgress;
+    }
+    pstcXfer->bBusy = TRUE;
+    PCF8574_EXIT_CRITICAL();
+    pstcXfer->enDir = Pcf8574XferWrite;
+    pstcXfer->u32Address = pstcHandle->u32Address;
+    pstcXfer->pfnDone = WriteXferDone;
+    pstcXfer->pHandle = pstcHandle;
+    pstcXfer->pUser = pUser;
+    pstcHandle->pfnWriteDone = pfnDone;
+    pstcHandle->pu8StreamNext = pu8Sequence;
+    pstcHandle->u32StreamRemain = u32Len;
+    WriteNextChunk(pstcHandle);
+    return Ok;
+}
+
+/**
+ ** \brief Service the devices without async bus of the IRQ scan of a group
+ **
+ ** After u32ScanBudget blocking reads the scan is split, the remaining
+ ** devices are serviced from the next ms tick.
+ **
+ ** \param pstcGroup Pointer of group
+ **
+ ** \param pstcItem First list item to service
+ */
+static void ScanContinue(stc_pcf8574_group_t* pstcGroup, stc_pcf8574_list_item_t* pstcItem)
+{
+    stc_pcf8574_list_item_t* apstcItems[PCF8574_TRANSFER_MAX_MSGS];
+    stc_pcf8574_handle_t* apstcDevices[PCF8574_TRANSFER_MAX_MSGS];
+    stc_pcf8574_handle_t* pstcDevice;
+    uint32_t u32Batch = 0;
+    uint32_t u32Reads = 0;
+#if PCF8574_REGISTRY_SIZE > 0
+    uint32_t i = (pstcItem == NULL) ? pstcGroup->u32RegCount : pstcItem->u16Slot;
+    for(;i < pstcGroup->u32RegCount;i++)
+    {
+        if (pstcGroup->apstcRegDevices[i]->pstcBus != NULL)
+        {
+            continue;
+        }
+        if ((pstcGroup->u32ScanBudget != 0) && (u32Reads >= pstcGroup->u32ScanBudget))
+        {
+            ServiceBatch(apstcItems,apstcDevices,u32Batch);
+            pstcGroup->pstcScanNext = pstcGroup->apstcRegItems[i];
+            Pcf8574_TimerStart(&pstcGroup->stcScanTimer,1,ScanTimerExpired,pstcGroup,NULL);
+            return;
+        }
+        pstcDevice = pstcGroup->apstcRegDevices[i];
+        if ((u32Batch == PCF8574_TRANSFER_MAX_MSGS) || ((u32Batch > 0) && !SameTransport(apstcDevices[0],pstcDevice)))
+        {
+            ServiceBatch(apstcItems,apstcDevices,u32Batch);
+            u32Batch = 0;
+        }
+        apstcItems[u32Batch] = pstcGroup->apstcRegItems[i];
+        apstcDevices[u32Batch++] = pstcDevice;
+        u32Reads++;
+    }
+#else
+    for(;pstcItem != NULL;pstcItem = pstcItem->Next)
+    {
+        pstcDevice = ItemDevice(pstcItem);
+        if (pstcDevice->pstcBus != NULL)
+        {
+            continue;
+        }
+        if ((pstcGroup->u32ScanBudget != 0) && (u32Reads >= pstcGroup->u32ScanBudget))
+        {
+            ServiceBatch(apstcItems,apstcDevices,u32Batch);
+            pstcGroup->pstcScanNext = pstcItem;
+            Pcf8574_TimerStart(&pstcGroup->stcScanTimer,1,ScanTimerExpired,pstcGroup,NULL);
+            return;
+        }
+        if ((u32Batch == PCF8574_TRANSFER_MAX_MSGS) || ((u32Batch > 0) && !SameTransport(apstcDevices[0],pstcDevice)))
+        {
+            ServiceBatch(apstcItems,apstcDevices,u32Batch);
+            u32Batch = 0;
+        }
+        apstcItems[u32Batch] = pstcItem;
+        apstcDevices[u32Batch++] = pstcDevice;
+        u32Reads++;
+    }
+#endif
+    ServiceBatch(apstcItems,apstcDevices,u32Batch);
+    pstcGroup->pstcScanNext = NULL;
+    ScanItemDone(pstcGroup);
+}
+
+/**
+ ** \brief Start the IRQ scan of a group
+ **
+ ** The reads of all devices with async bus are submitted first, so all
+ ** buses work in parallel and the scan time is set by the busiest bus.
+ ** Devices without async bus are serviced with blocking reads meanwhile.
+ **
+ ** \param pstcGroup Pointer of group
+ */
+static void ScanStart(stc_pcf8574_group_t* pstcGroup)
+{
+#if PCF8574_REGISTRY_SIZE > 0
+    uint32_t i;
+#else
+    stc_pcf8574_list_item_t* pstcItem;
+    stc_pcf8574_handle_t* pstcDevice;
+#endif
+    PCF8574_ENTER_CRITICAL();
+    pstcGroup->u32ScanOutstanding = 1;
+#if PCF8574_ENABLE_STATS
+    pstcGroup->bScanChanged = FALSE;
+#endif
+    PCF8574_EXIT_CRITICAL();
+#if PCF8574_REGISTRY_SIZE > 0
+    for(i = 0;i < pstcGroup->u32RegCount;i++)
+    {
+        if (pstcGroup->apstcRegDevices[i]->pstcBus != NULL)
+        {
+            PCF8574_ENTER_CRITICAL();
+            pstcGroup->u32ScanOutstanding++;
+            PCF8574_EXIT_CRITICAL();
+            if (StartRead(pstcGroup->apstcRegDevices[i],pstcGroup->apstcRegItems[i],NULL) != Ok)
+            {
+                ScanItemDone(pstcGroup);
+            }
+        }
+    }
+    ScanContinue(pstcGroup,(pstcGroup->u32RegCount > 0) ? pstcGroup->apstcRegItems[0] : NULL);
+#else
+    for(pstcItem = pstcGroup->pstcListRoot;pstcItem != NULL;pstcItem = pstcItem->Next)
+    {
+        pstcDevice = ItemDevice(pstcItem);
+        if (pstcDevice->pstcBus != NULL)
+        {
+            PCF8574_ENTER_CRITICAL();
+            pstcGroup->u32ScanOutstanding++;
+            PCF8574_EXIT_CRITICAL();
+            if (StartRead(pstcDevice,pstcItem,NULL) != Ok)
+            {
+                ScanItemDone(pstcGroup);
+            }
+        }
+    }
+    ScanContinue(pstcGroup,pstcGroup->pstcListRoot);
+#endif
+}
+
+/**
+ ** \brief Timer of a split IRQ scan expired, continue the scan, deferred while the group is locked
+ **
+ ** \param pstcTimer Scan timer of the group, pHandle is the group
+ */
+static void ScanTimerExpired(stc_pcf8574_timer_t* pstcTimer)
+{
+    stc_pcf8574_group_t* pstcGroup = pstcTimer->pHandle;
+    if (pstcGroup->bLock)
+    {
+        Pcf8574_TimerStart(pstcTimer,1,ScanTimerExpired,pstcGroup,NULL);
+        return;
+    }
+    ScanContinue(pstcGroup,pstcGroup->pstcScanNext);
+}
+
+/**
+ ** \brief Scan a group for an IRQ or a poll, honors the lock and a running scan
+ **
+ ** \param pstcGroup Pointer of group
+ */
+static void GroupScan(stc_pcf8574_group_t* pstcGroup)
+{
+    pstcGroup->bHandleIrq = TRUE;
+    if (pstcGroup->bLock == FALSE)
+    {
+        pstcGroup->bHandleIrq = FALSE;
+        PCF8574_ENTER_CRITICAL();
+        if (pstcGroup->bScanBusy)
+        {
+            if (!pstcGroup->bScanPending)
+            {
+                pstcGroup->u32PendingTick = u32Pcf8574Ticks;
+            }
+            pstcGroup->bScanPending = TRUE;
+            PCF8574_EXIT_CRITICAL();
+            return;
+        }
+        pstcGroup->bScanBusy = TRUE;
+        pstcGroup->u32ScanTick = u32Pcf8574Ticks;
+        PCF8574_EXIT_CRITICAL();
+        ScanStart(pstcGroup);
+    }
+}
+
+/**
+ ** \brief Count an IRQ of a group, switch to polling if the IRQ rate exceeds the storm threshold
+ **
+ ** \param pstcGroup Pointer of group
+ **
+ ** \returns TRUE if the group is polled and the IRQ is ignored
+ */
+static boolean_t StormIrq(stc_pcf8574_group_t* pstcGroup)
+{
+    uint32_t u32Now = u32Pcf8574Ticks;
+    if (pstcGroup->u32StormThreshold == 0)
+    {
+        return FALSE;
+    }
+    if (pstcGroup->bStorm)
+    {
+        pstcGroup->u32StormActivity++;    //IRQ not masked (no pfnIrqMask), still activity
+        return TRUE;
+    }
+    if ((u32Now - pstcGroup->u32StormWindowStart) >= PCF8574_STORM_WINDOW_MS)
+    {
+        pstcGroup->u32StormWindowStart = u32Now;
+        pstcGroup->u32StormIrqs = 0;
+    }
+    if (++pstcGroup->u32StormIrqs > pstcGroup->u32StormThreshold)
+    {
+        pstcGroup->bStorm = TRUE;
+        pstcGroup->u32StormEnters++;
+        pstcGroup->u32StormQuietStart = u32Now;
+        pstcGroup->u32StormLastActivity = pstcGroup->u32StormActivity;
+        if (pstcGroup->pfnIrqMask != NULL)
+        {
+            pstcGroup->pfnIrqMask(pstcGroup->pMaskHandle,TRUE);
+        }
+        Pcf8574_TimerStart(&pstcGroup->stcStormTimer,pstcGroup->u32StormPollMs,StormTimerExpired,pstcGroup,NULL);
+    }
+    return FALSE;
+}
+
+/**
+ ** \brief Storm timer of a group expired: poll the group, or recheck a still asserted INT line
+ **
+ ** A polled group returns to IRQ mode after PCF8574_STORM_WINDOW_MS
+ ** without device changes and with deasserted INT line (if pfnIntRead is
+ ** set), a final scan catches changes during the switch.
+ **
+ ** \param pstcTimer Storm timer of the group, pHandle is the group
+ */
+static void StormTimerExpired(stc_pcf8574_timer_t* pstcTimer)
+{
+    stc_pcf8574_group_t* pstcGroup = pstcTimer->pHandle;
+    uint32_t u32Now = u32Pcf8574Ticks;
+    if (!pstcGroup->bStorm)
+    {
+        Pcf8574_GroupIrqHandle(pstcGroup);
+        return;
+    }
+    if ((pstcGroup->u32StormActivity != pstcGroup->u32StormLastActivity) ||
+        ((pstcGroup->pfnIntRead != NULL) && pstcGroup->pfnIntRead(pstcGroup->pIntHandle)))
+    {
+        pstcGroup->u32StormQuietStart = u32Now;
+    }
+    pstcGroup->u32StormLastActivity = pstcGroup->u32StormActivity;
+    pstcGroup->u32IrqEpoch++;
+    if ((u32Now - pstcGroup->u32StormQuietStart) >= PCF8574_STORM_WINDOW_MS)
+    {
+        pstcGroup->bStorm = FALSE;
+        pstcGroup->u32StormExits++;
+        pstcGroup->u32StormWindowStart = u32Now;
+        pstcGroup->u32StormIrqs = 0;
+        if (pstcGroup->pfnIrqMask != NULL)
+        {
+            pstcGroup->pfnIrqMask(pstcGroup->pMaskHandle,FALSE);
+        }
+        GroupScan(pstcGroup);
+        return;
+    }
+    GroupScan(pstcGroup);
+    Pcf8574_TimerStart(pstcTimer,pstcGroup->u32StormPollMs,StormTimerExpired,pstcGroup,NULL);
+}
+
+/**
+ ** \brief One device of the IRQ scan of a group is done
+ **
+ ** When all devices are done, the scan is repeated if an IRQ occurred
+ ** in between.
+ **
+ ** \param pstcGroup Pointer of group
+ */
+static void ScanItemDone(stc_pcf8574_group_t* pstcGroup)
+{
+    boolean_t bRestart = FALSE;
+    boolean_t bRecheck = FALSE;
+    PCF8574_ENTER_CRITICAL();
+    pstcGroup->u32ScanOutstanding--;
+    if (pstcGroup->u32ScanOutstanding == 0)
+    {
+#if PCF8574_ENABLE_STATS
+        if (!pstcGroup->bScanChanged)
+        {
+            pstcGroup->stcStats.u32Spurious++;
+        }
+#endif
+        if (pstcGroup->bScanPending)
+        {
+            pstcGroup->bScanPending = FALSE;
+            pstcGroup->u32ScanTick = pstcGroup->u32PendingTick;
+            bRestart = TRUE;
+        } else
+        {
+            pstcGroup->bScanBusy = FALSE;
+            bRecheck = TRUE;
+        }
+    }
+    PCF8574_EXIT_CRITICAL();
+    if (bRestart)
+    {
+        ScanStart(pstcGroup);
+    }
+    if (bRecheck && !pstcGroup->bStorm && (pstcGroup->pfnIntRead != NULL) && !pstcGroup->stcStormTimer.bActive &&
+        pstcGroup->pfnIntRead(pstcGroup->pIntHandle))
+    {
+        //INT still asserted: a device changed after it was read, the line never went high and no edge will follow
+        Pcf8574_TimerStart(&pstcGroup->stcStormTimer,1,StormTimerExpired,pstcGroup,NULL);
+    }
+}
+
+/**
+ ** \brief Completion of one device of a group flush
+ **
+ ** \param pstcGroup Pointer of group
+ **
+ ** \param enResult Result of the device
+ */
+static void FlushItemDone(stc_pcf8574_group_t* pstcGroup, en_result_t enResult)
+{
+    pfn_pcf8574_group_done_t pfnDone = NULL;
+    PCF8574_ENTER_CRITICAL();
+    if (enResult != Ok)
+    {
+        pstcGroup->enFlushResult = enResult;
+    }
+    pstcGroup->u32FlushOutstanding--;
+    if (pstcGroup->u32FlushOutstanding == 0)
+    {
+        pfnDone = pstcGroup->pfnFlushDone;
+        pstcGroup->pfnFlushDone = NULL;
+    }
+    PCF8574_EXIT_CRITICAL();
+    if (pfnDone != NULL)
+    {
+        pfnDone(pstcGroup,pstcGroup->enFlushResult);
+    }
+}
+
+/**
+ ** \brief Write done callback of async devices of a group flush
+ **
+ ** \param pHandle Device handle
+ **
+ ** \param enResult Result of the write
+ */
+static void GroupFlushWriteDone(void* pHandle, en_result_t enResult)
+{
+    FlushItemDone(((stc_pcf8574_handle_t*)pHandle)->stcXferWrite.pUser,enResult);
+}
+
+/**
+ ** \brief Take the bytes of one poll from the poll budget
+ **
+ ** \param pstcBudget Pointer of budget or NULL
+ **
+ ** \param u32Bytes Bytes on the bus including the address byte
+ **
+ ** \returns 0 if the bytes were taken, else ms to wait until the bucket holds them
+ */
+static uint32_t PollBudgetTake(stc_pcf8574_poll_budget_t* pstcBudget, uint32_t u32Bytes)
+{
+    uint32_t u32Now = u32Pcf8574Ticks;
+    uint32_t u32Max;
+    uint32_t u32Elapsed;
+    uint32_t u32Wait = 0;
+    if ((pstcBudget == NULL) || (pstcBudget->u32BytesPerSecond == 0))
+    {
+        return 0;
+    }
+    PCF8574_ENTER_CRITICAL();
+    u32Bytes = MIN(u32Bytes,pstcBudget->u32Burst);    //a poll larger than the bucket waits for a full bucket
+    u32Max = pstcBudget->u32Burst * 1000;
+    u32Elapsed = u32Now - pstcBudget->u32LastRefill;
+    pstcBudget->u32LastRefill = u32Now;
+    if (u32Elapsed >= (u32Max / pstcBudget->u32BytesPerSecond))
+    {
+        pstcBudget->u32Tokens = u32Max;
+    } else
+    {
+        pstcBudget->u32Tokens = MIN(pstcBudget->u32Tokens + u32Elapsed * pstcBudget->u32BytesPerSecond,u32Max);
+    }
+    if (pstcBudget->u32Tokens >= (u32Bytes * 1000))
+    {
+        pstcBudget->u32Tokens -= u32Bytes * 1000;
+    } else
+    {
+        pstcBudget->u32Deferred++;
+        u32Wait = ((u32Bytes * 1000) - pstcBudget->u32Tokens + pstcBudget->u32BytesPerSecond - 1) / pstcBudget->u32BytesPerSecond;
+    }
+    PCF8574_EXIT_CRITICAL();
+    return u32Wait;
+}
+
+/**
+ ** \brief Schedule the next poll of a device
+ **
+ ** A change restarts at the minimum interval, every poll without change
+ ** doubles the interval up to the maximum interval.
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \param bChanged TRUE if the last poll saw a change
+ */
+static void PollReschedule(stc_pcf8574_handle_t* pstcHandle, boolean_t bChanged)
+{
+    if (pstcHandle->u32PollMaxMs == 0)
+    {
+        return;
+    }
+    if (bChanged)
+    {
+        pstcHandle->u32PollInterval = pstcHandle->u32PollMinMs;
+    } else if (pstcHandle->u32PollInterval >= (pstcHandle->u32PollMaxMs / 2))
+    {
+        pstcHandle->u32PollInterval = pstcHandle->u32PollMaxMs;
+    } else
+    {
+        pstcHandle->u32PollInterval *= 2;
+    }
+    Pcf8574_TimerStart(&pstcHandle->stcPollTimer,pstcHandle->u32PollInterval,PollTimerExpired,pstcHandle,pstcHandle->stcPollTimer.pUser);
+}
+
+/**
+ ** \brief Handle a polled port value like an IRQ sample and schedule the next poll
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \param portPrevious Port value before
+ **
+ ** \param portTmp Port value now
+ */
+static void PollApply(stc_pcf8574_handle_t* pstcHandle, pcf8574_port_t portPrevious, pcf8574_port_t portTmp)
+{
+    ApplyPortValue(pstcHandle->stcPollTimer.pUser,pstcHandle,portPrevious,portTmp);
+    PollReschedule(pstcHandle,(boolean_t)(portPrevious != portTmp));
+}
+
+/**
+ ** \brief Read done callback of async polls
+ **
+ ** \param pHandle Device handle
+ **
+ ** \param enResult Result of the read
+ */
+static void PollReadDone(void* pHandle, en_result_t enResult)
+{
+    stc_pcf8574_handle_t* pstcHandle = pHandle;
+    if (enResult != Ok)
+    {
+        PollReschedule(pstcHandle,FALSE);
+        return;
+    }
+    PollApply(pstcHandle,pstcHandle->portPollPrevious,pstcHandle->portCurrentValues);
+}
+
+/**
+ ** \brief Poll a device without INT line, deferred while the group is locked or the poll budget is exhausted
+ **
+ ** \param pstcTimer Poll timer of the device, pUser is the group
+ */
+static void PollTimerExpired(stc_pcf8574_timer_t* pstcTimer)
+{
+    stc_pcf8574_handle_t* pstcHandle = pstcTimer->pHandle;
+    stc_pcf8574_group_t* pstcGroup = pstcTimer->pUser;
+    pcf8574_port_t portPrevious = pstcHandle->portCurrentValues;
+    uint32_t u32Wait;
+    if (pstcHandle->u32PollMaxMs == 0)
+    {
+        return;
+    }
+    if (pstcGroup->bLock)
+    {
+        //the application accesses the bus, poll on the next tick
+        Pcf8574_TimerStart(pstcTimer,1,PollTimerExpired,pstcHandle,pstcGroup);
+        return;
+    }
+    u32Wait = PollBudgetTake(pstcHandle->pstcPollBudget,1 + (uint32_t)SampleCount(pstcHandle) * PortBytes(pstcHandle));
+    if (u32Wait != 0)
+    {
+        Pcf8574_TimerStart(pstcTimer,u32Wait,PollTimerExpired,pstcHandle,pstcTimer->pUser);
+        return;
+    }
+    if (pstcHandle->pstcBus != NULL)
+    {
+        if (StartRead(pstcHandle,NULL,PollReadDone) != Ok)
+        {
+            PollReschedule(pstcHandle,FALSE);
+        }
+        return;
+    }
+    PollApply(pstcHandle,portPrevious,ReadPort(pstcHandle));
+}
+
+/**
+ ** \brief Get interrupt group, NULL selects the default group
+ **
+ ** \param pstcGroup Pointer of group or NULL
+ **
+ ** \returns group to use
+ */
+static stc_pcf8574_group_t* GetGroup(stc_pcf8574_group_t* pstcGroup)
+{
+    return (pstcGroup == NULL) ? &stcPcf8574DefaultGroup : pstcGroup;
+}
+
+#if PCF8574_REGISTRY_SIZE > 0
+/**
+ ** \brief Add item to the registry of a group, sorted by priority
+ **
+ ** Items of equal or lower priority than the last item are appended in O(1).
+ **
+ ** \param pstcGroup Pointer of group
+ **
+ ** \param pstcListItem Pointer of list item to add
+ **
+ ** \returns Ok on success, ErrorBufferFull if the registry is full
+ */
+static en_result_t ListItemAdd(stc_pcf8574_group_t* pstcGroup, stc_pcf8574_list_item_t* pstcListItem)
+{
+    uint32_t i = pstcGroup->u32RegCount;
+    stc_pcf8574_handle_t* pstcDevice = ItemDevice(pstcListItem);
+    if (i >= PCF8574_REGISTRY_SIZE)
+    {
+        return ErrorBufferFull;
+    }
+    pstcListItem->pGroup = pstcGroup;
+    pstcListItem->Next = NULL;
+    while((i > 0) && (pstcGroup->au8RegPriority[i - 1] < pstcListItem->u8Priority))
+    {
+        pstcGroup->apstcRegItems[i] = pstcGroup->apstcRegItems[i - 1];
+        pstcGroup->apstcRegDevices[i] = pstcGroup->apstcRegDevices[i - 1];
+        pstcGroup->au8RegPriority[i] = pstcGroup->au8RegPriority[i - 1];
+        pstcGroup->apstcRegItems[i]->u16Slot = (uint16_t)i;
+        i--;
+    }
+    pstcGroup->apstcRegItems[i] = pstcListItem;
+    pstcGroup->apstcRegDevices[i] = pstcDevice;
+    pstcGroup->au8RegPriority[i] = pstcListItem->u8Priority;
+    pstcListItem->u16Slot = (uint16_t)i;
+    pstcGroup->u32RegCount++;
+    return Ok;
+}
+
+/**
+ ** \brief Remove item from the registry of a group
+ **
+ ** The slot is found in O(1), the items behind are moved up to keep the
+ ** priority order, removing the last item is O(1).
+ **
+ ** \param pstcGroup Pointer of group
+ **
+ ** \param pstcListItem Pointer of list item to remove
+ */
+static void ListItemRemove(stc_pcf8574_group_t* pstcGroup, stc_pcf8574_list_item_t* pstcListItem)
+{
+    uint32_t i = pstcListItem->u16Slot;
+    if ((i >= pstcGroup->u32RegCount) || (pstcGroup->apstcRegItems[i] != pstcListItem))
+    {
+        return;
+    }
+    pstcGroup->u32RegCount--;
+    for(;i < pstcGroup->u32RegCount;i++)
+    {
+        pstcGroup->apstcRegItems[i] = pstcGroup->apstcRegItems[i + 1];
+        pstcGroup->apstcRegDevices[i] = pstcGroup->apstcRegDevices[i + 1];
+        pstcGroup->au8RegPriority[i] = pstcGroup->au8RegPriority[i + 1];
+        pstcGroup->apstcRegItems[i]->u16Slot = (uint16_t)i;
+    }
+    if (pstcListItem == pstcGroup->pstcScanNext)
+    {
+        pstcGroup->pstcScanNext = (pstcListItem->u16Slot < pstcGroup->u32RegCount) ? pstcGroup->apstcRegItems[pstcListItem->u16Slot] : NULL;
+    }
+    pstcGroup->apstcRegItems[pstcGroup->u32RegCount] = NULL;
+}
+#else
+/**
+ ** \brief Add item to the linked list of a group, sorted by priority
+ **
+ ** \param pstcGroup Pointer of group
+ **
+ ** \param pstcListItem Pointer of list item to add
+ **
+ ** \returns Ok on success
+ */
+static en_result_t ListItemAdd(stc_pcf8574_group_t* pstcGroup, stc_pcf8574_list_item_t* pstcListItem)
+{
+    stc_pcf8574_list_item_t* pstcCurrent = pstcGroup->pstcListRoot;
+    stc_pcf8574_list_item_t* pstcLast = NULL;
+    pstcListItem->pGroup = pstcGroup;
+    while((pstcCurrent != NULL) && (pstcCurrent->u8Priority >= pstcListItem->u8Priority))
+    {
+        pstcLast = pstcCurrent;
+        pstcCurrent = pstcCurrent->Next;
+    }
+    pstcListItem->Next = pstcCurrent;
+    if (pstcLast == NULL)
+    {
+        pstcGroup->pstcListRoot = pstcListItem;
+    } else
+    {
+        pstcLast->Next = pstcListItem;
+    }
+    return Ok;
+}
+
+/**
+ ** \brief Remove item to the linked list of a group
+ **
+ ** \param pstcGroup Pointer of group
+ **
+ ** \param pstcListItem Pointer of list item to remove
+ **
+ */
+static void ListItemRemove(stc_pcf8574_group_t* pstcGroup, stc_pcf8574_list_item_t* pstcListItem)
+{
+    stc_pcf8574_list_item_t* pstcCurrent = pstcGroup->pstcListRoot;
+    stc_pcf8574_list_item_t* pstcLast = NULL;
+    if (pstcListItem == pstcGroup->pstcScanNext)
+    {
+        pstcGroup->pstcScanNext = pstcListItem->Next;
+    }
+    if (pstcListItem == pstcGroup->pstcListRoot)
+    {
+        pstcGroup->pstcListRoot = pstcListItem->Next;
+        pstcListItem->Next = NULL;
+        return;
+    }
+    while(pstcCurrent != pstcListItem)
+    {
+        if (pstcCurrent == NULL) return;
+        pstcLast = pstcCurrent;
+        pstcCurrent = pstcCurrent->Next;
+        if (pstcCurrent == NULL) return;
+    }
+    if (pstcLast != NULL)
+    {
+        pstcLast->Next = pstcCurrent->Next;
+        pstcListItem->Next = NULL;
+    }
+}
+#endif
+
+/**
+ ** \brief Init interrupt group
+ **
+ ** An interrupt group has its own device list, lock and pending flag, so
+ ** each INT line of the system scans only the devices connected to it.
+ **
+ ** \param pstcGroup Pointer of group
+ **
+ ** \returns Ok on success
+ */
+en_result_t Pcf8574_InitGroup(stc_pcf8574_group_t* pstcGroup)
+{
+    stc_pcf8574_group_t* pstcCurrent = pstcPcf8574GroupRoot;
+    if (pstcGroup == NULL)
+    {
+        return ErrorUninitialized;
+    }
+    while(pstcCurrent != NULL)
+    {
+        if (pstcCurrent == pstcGroup)
+        {
+            return ErrorInvalidMode;
+        }
+        pstcCurrent = pstcCurrent->Next;
+    }
+    pstcGroup->pstcListRoot = NULL;
+    pstcGroup->bLock = FALSE;
+    pstcGroup->bHandleIrq = FALSE;
+    pstcGroup->pastcEvents = NULL;
+    pstcGroup->u32EventSize = 0;
+    pstcGroup->u32EventHead = 0;
+    pstcGroup->u32EventTail = 0;
+    pstcGroup->u32EventOverflows = 0;
+    pstcGroup->u32ScanOutstanding = 0;
+    pstcGroup->u32FlushOutstanding = 0;
+    pstcGroup->pfnFlushDone = NULL;
+    pstcGroup->bScanBusy = FALSE;
+    pstcGroup->bScanPending = FALSE;
+    pstcGroup->u32ScanBudget = 0;
+    pstcGroup->pstcScanNext = NULL;
+    pstcGroup->u32DeadlineMisses = 0;
+    pstcGroup->pfnIntRead = NULL;
+    pstcGroup->pIntHandle = NULL;
+    pstcGroup->u32IrqEpoch = 0;
+    pstcGroup->pfnIrqMask = NULL;
+    pstcGroup->u32StormThreshold = 0;
+    pstcGroup->u32StormEnters = 0;
+    pstcGroup->u32StormExits = 0;
+    pstcGroup->bStorm = FALSE;
+    pstcGroup->stcStormTimer.bActive = FALSE;
+#if PCF8574_ENABLE_STATS
+    memset(&pstcGroup->stcStats,0,sizeof(stc_pcf8574_stats_t));
+#endif
+#if PCF8574_REGISTRY_SIZE > 0
+    pstcGroup->u32RegCount = 0;
+#endif
+    pstcGroup->Next = pstcPcf8574GroupRoot->Next;
+    pstcPcf8574GroupRoot->Next = pstcGroup;
+    return Ok;
+}
+
+/**
+ ** \brief Deinit interrupt group, the devices of the group are not serviced anymore
+ **
+ ** \param pstcGroup Pointer of group
+ **
+ ** \returns Ok on success
+ */
+en_result_t Pcf8574_DeinitGroup(stc_pcf8574_group_t* pstcGroup)
+{
+    stc_pcf8574_group_t* pstcCurrent = pstcPcf8574GroupRoot;
+    if ((pstcGroup == NULL) || (pstcGroup == &stcPcf8574DefaultGroup))
+    {
+        return ErrorInvalidParameter;
+    }
+    while(pstcCurrent->Next != NULL)
+    {
+        if (pstcCurrent->Next == pstcGroup)
+        {
+            pstcCurrent->Next = pstcGroup->Next;
+            pstcGroup->Next = NULL;
+            Pcf8574_TimerStop(&pstcGroup->stcScanTimer);
+            Pcf8574_TimerStop(&pstcGroup->stcStormTimer);
+            return Ok;
+        }
+        pstcCurrent = pstcCurrent->Next;
+    }
+    return ErrorInvalidParameter;
+}
+
+/**
+ ** \brief Init PCF8574 handle, device is added to the default interrupt group
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \param pstcListItemOut Pointer to optional list item to add (will be configured automatically)
+ **
+ ** \returns Ok on success
+ */
+en_result_t Pcf8574_Init(stc_pcf8574_handle_t* pstcHandle, stc_pcf8574_list_item_t* pstcListItemOut)
+{
+    return Pcf8574_InitInGroup(NULL,pstcHandle,pstcListItemOut);
+}
+
+/**
+ ** \brief Init PCF8574 handle as member of an interrupt group
+ **
+ ** The handle must be zeroed with PCF8574_CONFIG_INIT() before the
+ ** configuration fields (pI2cHandle, u32Address, pfnRead, pfnWrite and the
+ ** optional pstcBus, pfnTransfer, u8PortBits, ...) are set. Debouncing and
+ ** cached reads are switched off, enable them after the init. The device
+ ** is added to the group after the handle is initialized.
+ **
+ ** \param pstcGroup Pointer of group, NULL for the default group
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \param pstcListItemOut Pointer to optional list item to add (will be configured automatically)
+ **
+ ** \returns Ok on success
+ */
+en_result_t Pcf8574_InitInGroup(stc_pcf8574_group_t* pstcGroup, stc_pcf8574_handle_t* pstcHandle, stc_pcf8574_list_item_t* pstcListItemOut)
+{
+    int i;
+    if (pstcHandle == NULL)
+    {
+        return ErrorUninitialized;
+    }
+    pstcHandle->bDebounce = FALSE;
+    pstcHandle->pstcCacheGroup = NULL;
+    pstcHandle->bShadowValid = FALSE;
+    pstcHandle->u32CacheHits = 0;
+    pstcHandle->u32CacheMisses = 0;
+    pstcHandle->portOutputValues = PortMask(pstcHandle);
+    pstcHandle->portStagedValues = PortMask(pstcHandle);
+    pstcHandle->bOutputValid = FALSE;
+    pstcHandle->stcXferRead.bBusy = FALSE;
+    pstcHandle->stcXferRead.pUser = NULL;
+    pstcHandle->stcXferWrite.bBusy = FALSE;
+    pstcHandle->pfnReadDone = NULL;
+    pstcHandle->pfnWriteDone = NULL;
+    pstcHandle->u32StreamRemain = 0;
+    for(i = 0;i < PCF8574_MAX_PORT_BITS;i++)
+    {
+        UpdateEdgeMasks(pstcHandle,(uint8_t)i);
+    }
+    ReadSamples(pstcHandle,1,Pcf8574FilterNone);
+    pstcHandle->portDebounced = pstcHandle->portCurrentValues;
+    pstcHandle->portDebounceCnt0 = (pcf8574_port_t)~0;
+    pstcHandle->portDebounceCnt1 = (pcf8574_port_t)~0;
+    if (pstcListItemOut != NULL)
+    {
+        pstcListItemOut->Handle = pstcHandle;
+        pstcListItemOut->enType = Pcf8574ListTypeNone;
+        if (ListItemAdd(GetGroup(pstcGroup),pstcListItemOut) != Ok)
+        {
+            return ErrorBufferFull;
+        }
+        pstcHandle->pstcGroup = GetGroup(pstcGroup);
+    }
+    return Ok;
+}
+
+/**
+ ** \brief Enable or disable debouncing of a device
+ **
+ ** With debouncing the IRQ handling only samples the port, the callbacks
+ ** are called by Pcf8574_MsTickHandle() for GPIOs stable for 4 ticks.
+ ** The device must be added to a group with a list item.
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \param bEnable TRUE to enable
+ **
+ ** \returns Ok on success
+ */
+en_result_t Pcf8574_InitDebounce(stc_pcf8574_handle_t* pstcHandle, boolean_t bEnable)
+{
+    if (pstcHandle == NULL)
+    {
+        return ErrorUninitialized;
+    }
+    pstcHandle->bDebounce = FALSE;
+    Pcf8574_TimerStop(&pstcHandle->stcDebounceTimer);
+    pstcHandle->portDebounced = pstcHandle->portCurrentValues;
+    pstcHandle->portDebounceCnt0 = (pcf8574_port_t)~0;
+    pstcHandle->portDebounceCnt1 = (pcf8574_port_t)~0;
+    pstcHandle->bDebounce = bEnable;
+    return Ok;
+}
+
+/**
+ ** \brief Deinit PCF8574 handle of the default interrupt group
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \param pstcListItemOut Pointer to optional list item to add (will be configured automatically)
+ **
+ ** \returns Ok on success
+ */
+en_result_t Pcf8574_Deinit(stc_pcf8574_handle_t* pstcHandle, stc_pcf8574_list_item_t* pstcListItemOut)
+{
+    return Pcf8574_DeinitInGroup(NULL,pstcHandle,pstcListItemOut);
+}
+
+/**
+ ** \brief Deinit PCF8574 handle of an interrupt group
+ **
+ ** \param pstcGroup Pointer of group, NULL for the default group
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \param pstcListItemOut Pointer to optional list item to add (will be configured automatically)
+ **
+ ** \returns Ok on success
+ */
+en_result_t Pcf8574_DeinitInGroup(stc_pcf8574_group_t* pstcGroup, stc_pcf8574_handle_t* pstcHandle, stc_pcf8574_list_item_t* pstcListItemOut)
+{
+    if (pstcHandle == NULL)
+    {
+        return ErrorUninitialized;
+    }
+    if (pstcListItemOut != NULL)
+    {
+        pstcListItemOut->Handle = pstcHandle;
+        ListItemRemove(GetGroup(pstcGroup),pstcListItemOut);
+        pstcHandle->pstcGroup = NULL;
+    }
+    pstcHandle->bDebounce = FALSE;
+    Pcf8574_TimerStop(&pstcHandle->stcDebounceTimer);
+    Pcf8574_DeinitPoll(pstcHandle);
+    SeqRemove(pstcHandle);
+    pstcHandle->pstcCacheGroup = NULL;
+    return Ok;
+}
+
+/**
+ ** \brief Poll a device without INT line from Pcf8574_MsTickHandle()
+ **
+ ** Changes are handled like an IRQ of the device (callbacks, event queue of
+ ** the group, debouncing). The interval is u32MinMs after a change and
+ ** doubles with every poll without change up to u32MaxMs. Async devices
+ ** (pstcBus) are polled non-blocking. Devices sharing one bus should share
+ ** one budget, polls are deferred while the budget is exhausted and while
+ ** the group is locked (Pcf8574_GroupLockIrq()).
+ **
+ ** \param pstcGroup Pointer of group, NULL for the default group
+ **
+ ** \param pstcHandle Pointer of initialized handle
+ **
+ ** \param u32MinMs Poll interval after a change in ms, 1 or more
+ **
+ ** \param u32MaxMs Poll interval when idle in ms, u32MinMs or more
+ **
+ ** \param pstcBudget Bandwidth budget or NULL for unlimited
+ **
+ ** \returns Ok on success
+ */
+en_result_t Pcf8574_InitPoll(stc_pcf8574_group_t* pstcGroup, stc_pcf8574_handle_t* pstcHandle, uint32_t u32MinMs, uint32_t u32MaxMs, stc_pcf8574_poll_budget_t* pstcBudget)
+{
+    if (pstcHandle == NULL)
+    {
+        return ErrorUninitialized;
+    }
+    if ((u32MinMs == 0) || (u32MaxMs < u32MinMs))
+    {
+        return ErrorInvalidParameter;
+    }
+    Pcf8574_DeinitPoll(pstcHandle);
+    pstcHandle->pstcPollBudget = pstcBudget;
+    pstcHandle->u32PollMinMs = u32MinMs;
+    pstcHandle->u32PollMaxMs = u32MaxMs;
+    pstcHandle->u32PollInterval = u32MinMs;
+    return Pcf8574_TimerStart(&pstcHandle->stcPollTimer,u32MinMs,PollTimerExpired,pstcHandle,GetGroup(pstcGroup));
+}
+
+/**
+ ** \brief Stop polling a device
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \returns Ok on success
+ */
+en_result_t Pcf8574_DeinitPoll(stc_pcf8574_handle_t* pstcHandle)
+{
+    if (pstcHandle == NULL)
+    {
+        return ErrorUninitialized;
+    }
+    pstcHandle->u32PollMaxMs = 0;
+    Pcf8574_TimerStop(&pstcHandle->stcPollTimer);
+    return Ok;
+}
+
+/**
+ ** \brief Init a poll budget, a token bucket limiting the bus bandwidth of all polls using it
+ **
+ ** \param pstcBudget Pointer of budget
+ **
+ ** \param u32BytesPerSecond Bus bytes per second available for polls, 0 = unlimited
+ **
+ ** \param u32Burst Bucket size in bytes, should hold the bytes of one poll (address byte + port bytes per sample),
+ **                 a larger poll takes the full bucket
+ **
+ ** \returns Ok on success
+ */
+en_result_t Pcf8574_InitPollBudget(stc_pcf8574_poll_budget_t* pstcBudget, uint32_t u32BytesPerSecond, uint32_t u32Burst)
+{
+    if (pstcBudget == NULL)
+    {
+        return ErrorUninitialized;
+    }
+    if ((u32BytesPerSecond != 0) && ((u32Burst == 0) || (u32Burst > (0xFFFFFFFFUL / 1000))))
+    {
+        return ErrorInvalidParameter;
+    }
+    PCF8574_ENTER_CRITICAL();
+    pstcBudget->u32BytesPerSecond = u32BytesPerSecond;
+    pstcBudget->u32Burst = u32Burst;
+    pstcBudget->u32Tokens = u32Burst * 1000;
+    pstcBudget->u32LastRefill = u32Pcf8574Ticks;
+    pstcBudget->u32Deferred = 0;
+    PCF8574_EXIT_CRITICAL();
+    return Ok;
+}
+
+/**
+ ** \brief Set scan priority and deadline of a device or encoder
+ **
+ ** Devices with higher priority are read first in every IRQ scan (async
+ ** devices are queued first at their bus). A device serviced later than
+ ** u32MaxLatencyMs after the IRQ counts a deadline miss. Lock the IRQ
+ ** handling of the group while changing the priority of an added item.
+ **
+ ** \param pstcListItem Pointer of list item, can be added to a group already
+ **
+ ** \param u8Priority Priority, 0 = lowest (default)
+ **
+ ** \param u32MaxLatencyMs Maximum latency in ms, 0 = no deadline
+ **
+ ** \returns Ok on success
+ */
+en_result_t Pcf8574_SetPriority(stc_pcf8574_list_item_t* pstcListItem, uint8_t u8Priority, uint32_t u32MaxLatencyMs)
+{
+    stc_pcf8574_group_t* pstcGroup;
+    if (pstcListItem == NULL)
+    {
+        return ErrorUninitialized;
+    }
+    pstcGroup = pstcListItem->pGroup;
+    if (pstcGroup != NULL)
+    {
+        ListItemRemove(pstcGroup,pstcListItem);
+    }
+    pstcListItem->u8Priority = u8Priority;
+    pstcListItem->u32MaxLatencyMs = u32MaxLatencyMs;
+    pstcListItem->u32DeadlineMisses = 0;
+    if (pstcGroup != NULL)
+    {
+        ListItemAdd(pstcGroup,pstcListItem);
+    }
+    return Ok;
+}
+
+/**
+ ** \brief Limit the blocking reads of one IRQ scan step of a group
+ **
+ ** Long chains of devices without async bus are split: after u32MaxReads
+ ** reads the scan continues on the next ms tick of Pcf8574_MsTickHandle(),
+ ** so the time of one IRQ handling is bounded. With priorities, the
+ ** devices serviced first are the devices with the highest priority.
+ **
+ ** \param pstcGroup Pointer of group, NULL for the default group
+ **
+ ** \param u32MaxReads Blocking reads per scan step, 0 = unlimited (default)
+ **
+ ** \returns Ok on success
+ */
+en_result_t Pcf8574_InitScanBudget(stc_pcf8574_group_t* pstcGroup, uint32_t u32MaxReads)
+{
+    GetGroup(pstcGroup)->u32ScanBudget = u32MaxReads;
+    return Ok;
+}
+
+/**
+ ** \brief Init callback for a specific GPIO
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \param u8Bit Bit to address  between 0..7 (0..15 for 16-bit ports)
+ **
+ ** \param enType IRQ type, can be Pcf8574RisingEdge, Pcf8574FallingEdge, Pcf8574RisingFallingEdge
+ **
+ ** \param pfnCallback Callback of type pfn_pcf8574_callback_t, example: void Pcf8574Callback(void* pHandle, uint8_t u8Pin);
+ **
+ ** \returns Ok on success
+ */
+en_result_t Pcf8574_InitCallback(stc_pcf8574_handle_t* pstcHandle, uint8_t u8Bit, en_pcf8574_irq_trigger_t enType, pfn_pcf8574_callback_t pfnCallback)
+{
+    if (pstcHandle == NULL)
+    {
+        return ErrorUninitialized;
+    }
+    if (pfnCallback == NULL)
+    {
+        return ErrorUninitialized;
+    }
+    if (u8Bit >= PortBits(pstcHandle))
+    {
+        return ErrorInvalidParameter;
+    }
+    pstcHandle->astcCallbacks[u8Bit].enType = enType;
+    pstcHandle->astcCallbacks[u8Bit].pfnCallback = pfnCallback;
+    UpdateEdgeMasks(pstcHandle,u8Bit);
+    return Ok;
+}
+
+/**
+ ** \brief Deinit callback for a specific GPIO
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \param u8Bit Bit to address  between 0..7 (0..15 for 16-bit ports)
+ **
+ ** \returns Ok on success
+ */
+en_result_t Pcf8574_DeinitCallback(stc_pcf8574_handle_t* pstcHandle, uint8_t u8Bit)
+{
+    if (pstcHandle == NULL)
+    {
+        return ErrorUninitialized;
+    }
+    if (u8Bit >= PortBits(pstcHandle))
+    {
+        return ErrorInvalidParameter;
+    }
+    pstcHandle->astcCallbacks[u8Bit].enType = Pcf8574IrqNone;
+    pstcHandle->astcCallbacks[u8Bit].pfnCallback = NULL;
+    UpdateEdgeMasks(pstcHandle,u8Bit);
+    return Ok;
+}
+
+/**
+ ** \brief Init callback for all edges of the port
+ **
+ ** The callback is called once per IRQ handling with the masks of all rising
+ ** and all falling GPIOs, after the callbacks of the single GPIOs.
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \param pfnCallback Callback of type pfn_pcf8574_port_callback_t or NULL to remove,
+ **                    example: void Pcf8574PortCallback(void* pHandle, pcf8574_port_t portRiseMask, pcf8574_port_t portFallMask);
+ **
+ ** \returns Ok on success
+ */
+en_result_t Pcf8574_InitPortCallback(stc_pcf8574_handle_t* pstcHandle, pfn_pcf8574_port_callback_t pfnCallback)
+{
+    if (pstcHandle == NULL)
+    {
+        return ErrorUninitialized;
+    }
+    pstcHandle->pfnPortCallback = pfnCallback;
+    return Ok;
+}
+
+
+/**
+ ** \brief Read from PCF8574 handle
+ **
+ ** With cached reads (Pcf8574_InitCachedRead()) the shadow of the last
+ ** read is returned without bus transfer while the INT line of the group
+ ** is deasserted, no IRQ handling and no write happened since.
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \returns port value (8-bit or 16-bit) with the read GPIOs, the last read value if the transfer failed
+ */
+pcf8574_port_t Pcf8574_Read(stc_pcf8574_handle_t* pstcHandle)
+{
+    stc_pcf8574_group_t* pstcGroup;
+    uint8_t au8Data[PCF8574_MAX_PORT_BYTES];
+    pcf8574_port_t portValue;
+    uint32_t u32Epoch;
+    int iResult;
+    if (pstcHandle == NULL)
+    {
+        return 0;
+    }
+    pstcGroup = pstcHandle->pstcCacheGroup;
+    if ((pstcGroup == NULL) || (pstcGroup->pfnIntRead == NULL))
+    {
+        return ReadSamples(pstcHandle,1,Pcf8574FilterNone);
+    }
+    if (ShadowLoad(pstcHandle,&portValue,&u32Epoch) && !pstcGroup->pfnIntRead(pstcGroup->pIntHandle) &&
+        (u32Epoch == pstcGroup->u32IrqEpoch))
+    {
+        pstcHandle->u32CacheHits++;
+        return portValue;
+    }
+    pstcHandle->u32CacheMisses++;
+    u32Epoch = pstcGroup->u32IrqEpoch;
+    iResult = pstcHandle->pfnRead(pstcHandle->pI2cHandle,pstcHandle->u32Address,au8Data,PortBytes(pstcHandle));
+    portValue = StoreSamples(pstcHandle,au8Data,1,Pcf8574FilterNone,iResult);
+    ShadowPublish(pstcHandle,portValue,u32Epoch,(boolean_t)(iResult == 0));
+    return portValue;
+}
+
+/**
+ ** \brief Set the INT line read function of a group, required for cached reads
+ **
+ ** \param pstcGroup Pointer of group, NULL for the default group
+ **
+ ** \param pfnIntRead Returns TRUE while the INT line is asserted (low), NULL to disable cached reads
+ **
+ ** \param pIntHandle Handle for pfnIntRead
+ **
+ ** \returns Ok on success
+ */
+en_result_t Pcf8574_InitIntRead(stc_pcf8574_group_t* pstcGroup, pfn_pcf8574_int_read_t pfnIntRead, void* pIntHandle)
+{
+    pstcGroup = GetGroup(pstcGroup);
+    pstcGroup->pfnIntRead = NULL;
+    PCF8574_MEMORY_BARRIER();
+    pstcGroup->pIntHandle = pIntHandle;
+    pstcGroup->u32IrqEpoch++;
+    PCF8574_MEMORY_BARRIER();
+    pstcGroup->pfnIntRead = pfnIntRead;
+    return Ok;
+}
+
+/**
+ ** \brief Init interrupt storm mitigation of a group
+ **
+ ** A chattering input or a stuck INT line would rescan the group on every
+ ** edge. If more than u32Threshold IRQs occur within
+ ** PCF8574_STORM_WINDOW_MS, the INT interrupt is masked via pfnIrqMask and
+ ** the group is scanned every u32PollMs from Pcf8574_MsTickHandle(). After
+ ** PCF8574_STORM_WINDOW_MS without changes the interrupt is unmasked again.
+ ** IRQs while polled are ignored, so a missing pfnIrqMask only costs the
+ ** IRQ entry. With pfnIntRead (Pcf8574_InitIntRead()) an INT line still
+ ** asserted after a scan is rechecked on the next ms tick.
+ **
+ ** \param pstcGroup Pointer of group, NULL for the default group
+ **
+ ** \param u32Threshold IRQs per window, 0 = storm detection off
+ **
+ ** \param u32PollMs Poll interval in ms while polled
+ **
+ ** \param pfnIrqMask Masks (TRUE) and unmasks (FALSE) the MCU interrupt of the INT line, can be NULL
+ **
+ ** \param pMaskHandle Handle for pfnIrqMask
+ **
+ ** \returns Ok on success
+ */
+en_result_t Pcf8574_InitStorm(stc_pcf8574_group_t* pstcGroup, uint32_t u32Threshold, uint32_t u32PollMs, pfn_pcf8574_irq_mask_t pfnIrqMask, void* pMaskHandle)
+{
+    pstcGroup = GetGroup(pstcGroup);
+    if ((u32Threshold != 0) && (u32PollMs == 0))
+    {
+        return ErrorInvalidParameter;
+    }
+    Pcf8574_TimerStop(&pstcGroup->stcStormTimer);
+    if ((pstcGroup->bStorm) && (pstcGroup->pfnIrqMask != NULL))
+    {
+        pstcGroup->pfnIrqMask(pstcGroup->pMaskHandle,FALSE);
+    }
+    pstcGroup->bStorm = FALSE;
+    pstcGroup->u32StormThreshold = u32Threshold;
+    pstcGroup->u32StormPollMs = u32PollMs;
+    pstcGroup->pfnIrqMask = pfnIrqMask;
+    pstcGroup->pMaskHandle = pMaskHandle;
+    pstcGroup->u32StormIrqs = 0;
+    pstcGroup->u32StormWindowStart = u32Pcf8574Ticks;
+    pstcGroup->u32StormEnters = 0;
+    pstcGroup->u32StormExits = 0;
+    return Ok;
+}
+
+/**
+ ** \brief Get the interrupt storm state of a group
+ **
+ ** \param pstcGroup Pointer of group, NULL for the default group
+ **
+ ** \param pu32Enters Switches to polling, can be NULL
+ **
+ ** \param pu32Exits Switches back to IRQ mode, can be NULL
+ **
+ ** \returns TRUE while the group is polled
+ */
+boolean_t Pcf8574_GetStormStatus(stc_pcf8574_group_t* pstcGroup, uint32_t* pu32Enters, uint32_t* pu32Exits)
+{
+    pstcGroup = GetGroup(pstcGroup);
+    if (pu32Enters != NULL)
+    {
+        *pu32Enters = pstcGroup->u32StormEnters;
+    }
+    if (pu32Exits != NULL)
+    {
+        *pu32Exits = pstcGroup->u32StormExits;
+    }
+    return pstcGroup->bStorm;
+}
+
+/**
+ ** \brief Enable cached reads of a device
+ **
+ ** The INT output of the device must be connected to the INT line of the
+ ** group, Pcf8574_GroupIrqHandle() must be called for every falling edge.
+ ** While the INT line is deasserted, the GPIOs equal the last read value,
+ ** so Pcf8574_Read() returns the shadow of the last read without I2C
+ ** traffic. IRQ handling and writes invalidate the shadow. The shadow is
+ ** published through a seqlock, Pcf8574_Read() may be called from other
+ ** threads or cores without locks.
+ **
+ ** \param pstcGroup Pointer of group, NULL for the default group
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \param bEnable TRUE to enable
+ **
+ ** \returns Ok on success
+ */
+en_result_t Pcf8574_InitCachedRead(stc_pcf8574_group_t* pstcGroup, stc_pcf8574_handle_t* pstcHandle, boolean_t bEnable)
+{
+    if (pstcHandle == NULL)
+    {
+        return ErrorUninitialized;
+    }
+    pstcHandle->pstcCacheGroup = NULL;
+    ShadowPublish(pstcHandle,pstcHandle->portCurrentValues,0,FALSE);
+    pstcHandle->u32CacheHits = 0;
+    pstcHandle->u32CacheMisses = 0;
+    PCF8574_MEMORY_BARRIER();
+    pstcHandle->pstcCacheGroup = bEnable ? GetGroup(pstcGroup) : NULL;
+    return Ok;
+}
+
+/**
+ ** \brief Read all devices of a group as one consistent image
+ **
+ ** Consecutive devices with the same vectored transport (pfnTransfer) are
+ ** sampled in one combined transaction, so a group on one bus with at most
+ ** PCF8574_TRANSFER_MAX_MSGS devices is read in a single transfer.
+ ** Like Pcf8574_Read(), the values are stored as portCurrentValues of the
+ ** devices, no callbacks are called.
+ **
+ ** \param pstcGroup Pointer of group, NULL for the default group
+ **
+ ** \param paportValues Port values in the order of the group (scan order)
+ **
+ ** \param u32Size Number of entries of paportValues
+ **
+ ** \param pstcSnapshot Time stamp and transfer information of the image
+ **
+ ** \returns Ok on success, Error if a device failed, ErrorBufferFull if the group has more than u32Size devices
+ */
+en_result_t Pcf8574_ReadAll(stc_pcf8574_group_t* pstcGroup, pcf8574_port_t* paportValues, uint32_t u32Size, stc_pcf8574_snapshot_t* pstcSnapshot)
+{
+    stc_pcf8574_handle_t* apstcDevices[PCF8574_TRANSFER_MAX_MSGS];
+    uint32_t u32Batch = 0;
+    uint32_t u32Done = 0;
+#if PCF8574_REGISTRY_SIZE > 0
+    uint32_t i;
+#else
+    stc_pcf8574_list_item_t* pstcItem;
+#endif
+    if ((paportValues == NULL) || (pstcSnapshot == NULL))
+    {
+        return ErrorUninitialized;
+    }
+    pstcGroup = GetGroup(pstcGroup);
+    pstcSnapshot->u32Count = 0;
+#if PCF8574_REGISTRY_SIZE > 0
+    pstcSnapshot->u32Count = pstcGroup->u32RegCount;
+#else
+    for(pstcItem = pstcGroup->pstcListRoot;pstcItem != NULL;pstcItem = pstcItem->Next)
+    {
+        pstcSnapshot->u32Count++;
+    }
+#endif
+    if (pstcSnapshot->u32Count > u32Size)
+    {
+        return ErrorBufferFull;
+    }
+    pstcSnapshot->u32Timestamp = u32Pcf8574Ticks;
+    pstcSnapshot->u32Transfers = 0;
+    pstcSnapshot->u32Errors = 0;
+#if PCF8574_REGISTRY_SIZE > 0
+    for(i = 0;i < pstcGroup->u32RegCount;i++)
+    {
+        SnapshotAdd(apstcDevices,&u32Batch,pstcGroup->apstcRegDevices[i],paportValues,&u32Done,pstcSnapshot);
+    }
+#else
+    for(pstcItem = pstcGroup->pstcListRoot;pstcItem != NULL;pstcItem = pstcItem->Next)
+    {
+        SnapshotAdd(apstcDevices,&u32Batch,ItemDevice(pstcItem),paportValues,&u32Done,pstcSnapshot);
+    }
+#endif
+    SnapshotAdd(apstcDevices,&u32Batch,NULL,paportValues,&u32Done,pstcSnapshot);
+    return (pstcSnapshot->u32Errors == 0) ? Ok : Error;
+}
+
+/**
+ ** \brief Read several samples of the port in one transaction and filter them
+ **
+ ** The PCF8574 returns a fresh port sample for each byte (PCF8575: each two
+ ** bytes) read within one transaction, so one read can carry up to
+ ** PCF8574_MAX_BURST_SAMPLES samples.
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \param u8Samples Number of samples between 1..PCF8574_MAX_BURST_SAMPLES
+ **
+ ** \param enFilter Filter, can be Pcf8574FilterNone, Pcf8574FilterMajority, Pcf8574FilterConsecutive
+ **
+ ** \returns port value (8-bit or 16-bit) with the filtered GPIOs
+ */
+pcf8574_port_t Pcf8574_ReadBurst(stc_pcf8574_handle_t* pstcHandle, uint8_t u8Samples, en_pcf8574_filter_t enFilter)
+{
+    if (pstcHandle == NULL)
+    {
+        return 0;
+    }
+    if (u8Samples == 0)
+    {
+        u8Samples = 1;
+    }
+    if (u8Samples > PCF8574_MAX_BURST_SAMPLES)
+    {
+        u8Samples = PCF8574_MAX_BURST_SAMPLES;
+    }
+    return ReadSamples(pstcHandle,u8Samples,enFilter);
+}
+
+/**
+ ** \brief Write to PCF8574 handle
+ **
+ ** The value is also taken as staged value. If the transfer fails, the
+ ** next Pcf8574_Flush() writes again.
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \param portValue Write port value (8-bit or 16-bit) to GPIOs
+ */
+void Pcf8574_Write(stc_pcf8574_handle_t* pstcHandle, pcf8574_port_t portValue)
+{
+    uint8_t au8Data[PCF8574_MAX_PORT_BYTES];
+    int iResult;
+    if (pstcHandle == NULL)
+    {
+        return;
+    }
+    pstcHandle->portStagedValues = portValue;
+    EncodePort(portValue,au8Data,PortBytes(pstcHandle));
+    iResult = pstcHandle->pfnWrite(pstcHandle->pI2cHandle,pstcHandle->u32Address,au8Data,PortBytes(pstcHandle));
+    StatsTransfer(pstcHandle,FALSE,PortBytes(pstcHandle),iResult);
+    ShadowInvalidate(pstcHandle);
+    if (iResult != 0)
+    {
+        pstcHandle->bOutputValid = FALSE;
+        return;
+    }
+    pstcHandle->portOutputValues = portValue;
+    pstcHandle->bOutputValid = TRUE;
+}
+
+/**
+ ** \brief Stage a GPIO high (or input), written with the next Pcf8574_Flush()
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \param u8Bit Bit to address  between 0..7 (0..15 for 16-bit ports)
+ **
+ ** \returns Ok on success
+ */
+en_result_t Pcf8574_SetPin(stc_pcf8574_handle_t* pstcHandle, uint8_t u8Bit)
+{
+    if (pstcHandle == NULL)
+    {
+        return ErrorUninitialized;
+    }
+    if (u8Bit >= PortBits(pstcHandle))
+    {
+        return ErrorInvalidParameter;
+    }
+    PCF8574_ENTER_CRITICAL();
+    pstcHandle->portStagedValues |= (pcf8574_port_t)((pcf8574_port_t)1 << u8Bit);
+    PCF8574_EXIT_CRITICAL();
+    return Ok;
+}
+
+/**
+ ** \brief Stage a GPIO low, written with the next Pcf8574_Flush()
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \param u8Bit Bit to address  between 0..7 (0..15 for 16-bit ports)
+ **
+ ** \returns Ok on success
+ */
+en_result_t Pcf8574_ClearPin(stc_pcf8574_handle_t* pstcHandle, uint8_t u8Bit)
+{
+    if (pstcHandle == NULL)
+    {
+        return ErrorUninitialized;
+    }
+    if (u8Bit >= PortBits(pstcHandle))
+    {
+        return ErrorInvalidParameter;
+    }
+    PCF8574_ENTER_CRITICAL();
+    pstcHandle->portStagedValues &= (pcf8574_port_t)~((pcf8574_port_t)1 << u8Bit);
+    PCF8574_EXIT_CRITICAL();
+    return Ok;
+}
+
+/**
+ ** \brief Stage toggling a GPIO, written with the next Pcf8574_Flush()
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \param u8Bit Bit to address  between 0..7 (0..15 for 16-bit ports)
+ **
+ ** \returns Ok on success
+ */
+en_result_t Pcf8574_TogglePin(stc_pcf8574_handle_t* pstcHandle, uint8_t u8Bit)
+{
+    if (pstcHandle == NULL)
+    {
+        return ErrorUninitialized;
+    }
+    if (u8Bit >= PortBits(pstcHandle))
+    {
+        return ErrorInvalidParameter;
+    }
+    PCF8574_ENTER_CRITICAL();
+    pstcHandle->portStagedValues ^= (pcf8574_port_t)((pcf8574_port_t)1 << u8Bit);
+    PCF8574_EXIT_CRITICAL();
+    return Ok;
+}
+
+/**
+ ** \brief Stage all GPIOs in a mask high (or input)
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \param portMask GPIOs to set
+ */
+void Pcf8574_SetPins(stc_pcf8574_handle_t* pstcHandle, pcf8574_port_t portMask)
+{
+    Pcf8574_ModifyPins(pstcHandle,0,portMask);
+}
+
+/**
+ ** \brief Stage all GPIOs in a mask low
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \param portMask GPIOs to clear
+ */
+void Pcf8574_ClearPins(stc_pcf8574_handle_t* pstcHandle, pcf8574_port_t portMask)
+{
+    Pcf8574_ModifyPins(pstcHandle,portMask,0);
+}
+
+/**
+ ** \brief Stage toggling all GPIOs in a mask
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \param portMask GPIOs to toggle
+ */
+void Pcf8574_TogglePins(stc_pcf8574_handle_t* pstcHandle, pcf8574_port_t portMask)
+{
+    if (pstcHandle == NULL)
+    {
+        return;
+    }
+    PCF8574_ENTER_CRITICAL();
+    pstcHandle->portStagedValues ^= portMask;
+    PCF8574_EXIT_CRITICAL();
+}
+
+/**
+ ** \brief Stage clearing and setting GPIOs in one step, set wins over clear
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \param portClearMask GPIOs to clear
+ **
+ ** \param portSetMask GPIOs to set
+ */
+void Pcf8574_ModifyPins(stc_pcf8574_handle_t* pstcHandle, pcf8574_port_t portClearMask, pcf8574_port_t portSetMask)
+{
+    if (pstcHandle == NULL)
+    {
+        return;
+    }
+    PCF8574_ENTER_CRITICAL();
+    pstcHandle->portStagedValues = (pcf8574_port_t)((pstcHandle->portStagedValues & ~portClearMask) | portSetMask);
+    PCF8574_EXIT_CRITICAL();
+}
+
+/**
+ ** \brief Write all staged GPIO changes in one transfer
+ **
+ ** The write is skipped if the staged value equals the value already latched
+ ** in the device.
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \returns Ok on success
+ */
+en_result_t Pcf8574_Flush(stc_pcf8574_handle_t* pstcHandle)
+{
+    if (pstcHandle == NULL)
+    {
+        return ErrorUninitialized;
+    }
+    if ((pstcHandle->bOutputValid) && (pstcHandle->portStagedValues == pstcHandle->portOutputValues))
+    {
+        return Ok;
+    }
+    Pcf8574_Write(pstcHandle,pstcHandle->portStagedValues);
+    return (pstcHandle->bOutputValid) ? Ok : Error;
+}
+
+
+/**
+ ** \brief Write a sequence of port states as one I2C write transaction
+ **
+ ** The PCF8574 latches every byte of a write transaction, so each byte of
+ ** the sequence appears at the GPIOs one after another at bus speed.
+ ** For 16-bit ports each port state is two bytes, P0..P7 first.
+ ** If u32MaxTransferLen of the handle is not 0, the sequence is split into
+ ** transfers of at most u32MaxTransferLen bytes.
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \param pu8Sequence Port states to write
+ **
+ ** \param u32Len Number of port states
+ **
+ ** \returns Ok on success
+ */
+en_result_t Pcf8574_WriteStream(stc_pcf8574_handle_t* pstcHandle, const uint8_t* pu8Sequence, uint32_t u32Len)
+{
+    uint32_t u32Chunk;
+    uint8_t u8Bytes;
+    int iResult;
+    if ((pstcHandle == NULL) || (pu8Sequence == NULL))
+    {
+        return ErrorUninitialized;
+    }
+    if (u32Len == 0)
+    {
+        return ErrorInvalidParameter;
+    }
+    u8Bytes = PortBytes(pstcHandle);
+    u32Len *= u8Bytes;
+    while(u32Len > 0)
+    {
+        u32Chunk = ChunkLen(pstcHandle,u32Len);
+        iResult = pstcHandle->pfnWrite(pstcHandle->pI2cHandle,pstcHandle->u32Address,(uint8_t*)pu8Sequence,u32Chunk);
+        StatsTransfer(pstcHandle,FALSE,u32Chunk,iResult);
+        ShadowInvalidate(pstcHandle);
+        if (iResult != 0)
+        {
+            pstcHandle->bOutputValid = FALSE;
+            return Error;
+        }
+        pu8Sequence += u32Chunk;
+        u32Len -= u32Chunk;
+    }
+    pstcHandle->portOutputValues = DecodePort(pu8Sequence - u8Bytes,u8Bytes);
+    pstcHandle->portStagedValues = pstcHandle->portOutputValues;
+    pstcHandle->bOutputValid = TRUE;
+    return Ok;
+}
+
+/**
+ ** \brief Init async I2C bus
+ **
+ ** Devices with pstcBus set to the bus do their transfers non-blocking via
+ ** the async transport. The transfers of all devices on the bus are queued.
+ **
+ ** \param pstcBus Pointer of bus
+ **
+ ** \param pI2cHandle I2C handle passed to the transport
+ **
+ ** \param pfnSubmit Async transport, example: int I2CSubmit(void* pHandle, stc_pcf8574_xfer_t* pstcXfer);
+ **
+ ** \returns Ok on success
+ */
+en_result_t Pcf8574_InitBus(stc_pcf8574_bus_t* pstcBus, void* pI2cHandle, pfn_pcf8574_i2c_submit_t pfnSubmit)
+{
+    if ((pstcBus == NULL) || (pfnSubmit == NULL))
+    {
+        return ErrorUninitialized;
+    }
+    pstcBus->pI2cHandle = pI2cHandle;
+    pstcBus->pfnSubmit = pfnSubmit;
+    pstcBus->pstcHead = NULL;
+    pstcBus->pstcTail = NULL;
+    return Ok;
+}
+
+/**
+ ** \brief Called by the async transport when a transfer has finished, can be called from IRQ context
+ **
+ ** The next queued transfer of the bus is started before the completion of
+ ** the finished transfer is processed.
+ **
+ ** \param pstcXfer Pointer of transfer
+ **
+ ** \param iResult 0 on success
+ */
+void Pcf8574_XferComplete(stc_pcf8574_xfer_t* pstcXfer, int iResult)
+{
+    stc_pcf8574_bus_t* pstcBus;
+    stc_pcf8574_xfer_t* pstcNext;
+    int iNextResult;
+    if (pstcXfer == NULL)
+    {
+        return;
+    }
+    pstcBus = pstcXfer->pBus;
+    PCF8574_ENTER_CRITICAL();
+    pstcNext = pstcXfer->Next;
+    pstcBus->pstcHead = pstcNext;
+    if (pstcNext == NULL)
+    {
+        pstcBus->pstcTail = NULL;
+    }
+    PCF8574_EXIT_CRITICAL();
+    pstcXfer->Next = NULL;
+    if (pstcNext != NULL)
+    {
+        iNextResult = pstcBus->pfnSubmit(pstcBus->pI2cHandle,pstcNext);
+        if (iNextResult != 0)
+        {
+            pstcXfer->pfnDone(pstcXfer,iResult);
+            Pcf8574_XferComplete(pstcNext,iNextResult);
+            return;
+        }
+    }
+    pstcXfer->pfnDone(pstcXfer,iResult);
+}
+
+/**
+ ** \brief Read from PCF8574 handle non-blocking (requires pstcBus)
+ **
+ ** When done, portCurrentValues holds the read GPIOs (filtered if burst
+ ** reading is configured).
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \param pfnDone Done callback, example: void Pcf8574Done(void* pHandle, en_result_t enResult);
+ **
+ ** \returns Ok if the read was started
+ */
+en_result_t Pcf8574_ReadAsync(stc_pcf8574_handle_t* pstcHandle, pfn_pcf8574_done_t pfnDone)
+{
+    if ((pstcHandle == NULL) || (pstcHandle->pstcBus == NULL) || (pfnDone == NULL))
+    {
+        return ErrorUninitialized;
+    }
+    return StartRead(pstcHandle,NULL,pfnDone);
+}
+
+/**
+ ** \brief Write to PCF8574 handle non-blocking (requires pstcBus)
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \param portValue Write port value (8-bit or 16-bit) to GPIOs, also taken as staged value
+ **
+ ** \param pfnDone Done callback or NULL
+ **
+ ** \returns Ok if the write was started
+ */
+en_result_t Pcf8574_WriteAsync(stc_pcf8574_handle_t* pstcHandle, pcf8574_port_t portValue, pfn_pcf8574_done_t pfnDone)
+{
+    if ((pstcHandle == NULL) || (pstcHandle->pstcBus == NULL))
+    {
+        return ErrorUninitialized;
+    }
+    if (pstcHandle->stcXferWrite.bBusy)
+    {
+        return ErrorOperationInProgress;
+    }
+    EncodePort(portValue,pstcHandle->au8WriteData,PortBytes(pstcHandle));
+    pstcHandle->portStagedValues = portValue;
+    return StartWrite(pstcHandle,pstcHandle->au8WriteData,PortBytes(pstcHandle),pfnDone,NULL);
+}
+
+/**
+ ** \brief Write all staged GPIO changes non-blocking (requires pstcBus)
+ **
+ ** If nothing has changed, no transfer is started and pfnDone is called
+ ** immediately.
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \param pfnDone Done callback or NULL
+ **
+ ** \returns Ok if the write was started or not required
+ */
+en_result_t Pcf8574_FlushAsync(stc_pcf8574_handle_t* pstcHandle, pfn_pcf8574_done_t pfnDone)
+{
+    if ((pstcHandle == NULL) || (pstcHandle->pstcBus == NULL))
+    {
+        return ErrorUninitialized;
+    }
+    if (pstcHandle->stcXferWrite.bBusy)
+    {
+        return ErrorOperationInProgress;
+    }
+    if ((pstcHandle->bOutputValid) && (pstcHandle->portStagedValues == pstcHandle->portOutputValues))
+    {
+        if (pfnDone != NULL)
+        {
+            pfnDone(pstcHandle,Ok);
+        }
+        return Ok;
+    }
+    EncodePort(pstcHandle->portStagedValues,pstcHandle->au8WriteData,PortBytes(pstcHandle));
+    return StartWrite(pstcHandle,pstcHandle->au8WriteData,PortBytes(pstcHandle),pfnDone,NULL);
+}
+
+/**
+ ** \brief Write a sequence of port states non-blocking (requires pstcBus)
+ **
+ ** Same as Pcf8574_WriteStream(), chunks are chained without blocking.
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \param pu8Sequence Port states to write, must stay valid until done
+ **
+ ** \param u32Len Number of port states
+ **
+ ** \param pfnDone Done callback or NULL
+ **
+ ** \returns Ok if the write was started
+ */
+en_result_t Pcf8574_WriteStreamAsync(stc_pcf8574_handle_t* pstcHandle, const uint8_t* pu8Sequence, uint32_t u32Len, pfn_pcf8574_done_t pfnDone)
+{
+    if ((pstcHandle == NULL) || (pstcHandle->pstcBus == NULL) || (pu8Sequence == NULL))
+    {
+        return ErrorUninitialized;
+    }
+    if (u32Len == 0)
+    {
+        return ErrorInvalidParameter;
+    }
+    if (pstcHandle->stcXferWrite.bBusy)
+    {
+        return ErrorOperationInProgress;
+    }
+    u32Len *= PortBytes(pstcHandle);
+    pstcHandle->portStagedValues = DecodePort(&pu8Sequence[u32Len - PortBytes(pstcHandle)],PortBytes(pstcHandle));
+    return StartWrite(pstcHandle,pu8Sequence,u32Len,pfnDone,NULL);
+}
+
+/**
+ ** \brief Init PCF8574 rotary encoder handle, encoder is added to the default interrupt group
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \param pstcListItemOut Pointer to optional list item to add (will be configured automatically)
+ **
+ ** \returns Ok on success
+ */
+en_result_t Pcf8574_InitRotaryEncoder(stc_pcf8574_rotaryencoder_t* pstcHandle, stc_pcf8574_list_item_t* pstcListItemOut)
+{
+    return Pcf8574_InitRotaryEncoderInGroup(NULL,pstcHandle,pstcListItemOut);
+}
+
+/**
+ ** \brief Init PCF8574 rotary encoder handle as member of an interrupt group
+ **
+ ** \param pstcGroup Pointer of group, NULL for the default group
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \param pstcListItemOut Pointer to optional list item to add (will be configured automatically)
+ **
+ ** \returns Ok on success
+ */
+en_result_t Pcf8574_InitRotaryEncoderInGroup(stc_pcf8574_group_t* pstcGroup, stc_pcf8574_rotaryencoder_t* pstcHandle, stc_pcf8574_list_item_t* pstcListItemOut)
+{
+    if ((pstcHandle == NULL) || (pstcHandle->pHandle == NULL))
+    {
+        return ErrorUninitialized;
+    }
+    Pcf8574_Init(pstcHandle->pHandle,NULL);
+    Pcf8574_TimerStop(&pstcHandle->stcButtonTimer);
+    Pcf8574_TimerStop(&pstcHandle->stcIdleTimer);
+    Pcf8574_SetPins(pstcHandle->pHandle,(pcf8574_port_t)((1 << pstcHandle->A) | (1 << pstcHandle->B)));
+    Pcf8574_Flush(pstcHandle->pHandle);
+    pstcHandle->portOldData = Pcf8574_Read(pstcHandle->pHandle);
+    pstcHandle->u8QuadState = QuadState(pstcHandle,pstcHandle->portOldData);
+    pstcHandle->u32QuadErrors = 0;
+    pstcHandle->i32Velocity = 0;
+    pstcHandle->i32Acceleration = 0;
+    pstcHandle->u32LastStepTime = u32Pcf8574Ticks;
+    if (pstcListItemOut != NULL)
+    {
+        pstcListItemOut->Handle = pstcHandle;
+        pstcListItemOut->enType = Pcf8574ListTypeEncoder;
+        if (ListItemAdd(GetGroup(pstcGroup),pstcListItemOut) != Ok)
+        {
+            return ErrorBufferFull;
+        }
+        pstcHandle->pHandle->pstcGroup = GetGroup(pstcGroup);
+    }
+    return Ok;
+}
+
+
+/**
+ ** \brief Execute IRQ handling caused by INT pin for a specific device
+ **
+ ** For a debounced device the sample starts the debounce timer, the edges
+ ** are delivered by Pcf8574_MsTickHandle() through the group the device
+ ** is listed in (event queue of the group), directly if it is not listed.
+ **
+ ** \param pstcHandle Handle
+ */
+void Pcf8574_ExecuteIrqHandle(stc_pcf8574_handle_t* pstcHandle)
+{
+    pcf8574_port_t portTmp;
+    pcf8574_port_t portChanges;
+#if PCF8574_ENABLE_STATS
+    uint32_t u32Start = (uint32_t)PCF8574_STATS_TIMESTAMP();
+#endif
+    if (pstcHandle == NULL)
+    {
+        return;
+    }
+    portChanges = pstcHandle->portCurrentValues;
+    portTmp = ReadPort(pstcHandle);
+    portChanges ^= portTmp;
+    PCF8574_STATS_INC(pstcHandle,u32Irqs);
+    if (portChanges == 0)
+    {
+        PCF8574_STATS_INC(pstcHandle,u32Spurious);
+    }
+    if (!pstcHandle->bDebounce)
+    {
+        DispatchEdges(pstcHandle,(pcf8574_port_t)(portChanges & portTmp),(pcf8574_port_t)(portChanges & ~portTmp));
+    } else if ((!pstcHandle->stcDebounceTimer.bActive) && (portTmp != pstcHandle->portDebounced))
+    {
+        Pcf8574_TimerStart(&pstcHandle->stcDebounceTimer,1,DebounceTimerExpired,pstcHandle,pstcHandle->pstcGroup);
+    }
+#if PCF8574_ENABLE_STATS
+    StatsIsrDuration(&pstcHandle->stcStats,u32Start);
+#endif
+}
+
+/**
+ ** \brief Process type rotary encoder handle
+ **
+ ** \param pstcHandle Handle
+ */
+void Pcf8574_HandleRotaryEncoder(stc_pcf8574_rotaryencoder_t* pstcHandle)
+{
+    ProcessRotaryEncoder(pstcHandle,ReadPort(pstcHandle->pHandle));
+}
+
+/**
+ ** \brief Init keypad handle and add it to an interrupt group
+ **
+ ** The columns are driven low while idle, a key pulls its row low and the
+ ** INT line wakes the IRQ handling. The matrix is scanned once per key
+ ** change, PCF8574_KEYPAD_DEBOUNCE_MS after the INT. The keypad device
+ ** needs blocking transfers (no pstcBus), other GPIOs of the device keep
+ ** their staged values.
+ **
+ ** \param pstcGroup Pointer of group, NULL for the default group
+ **
+ ** \param pstcHandle Keypad handle, pHandle, portRows, portCols and pfnCallback set
+ **
+ ** \param pstcListItemOut Pointer to list item to add (will be configured automatically)
+ **
+ ** \returns Ok on success
+ */
+en_result_t Pcf8574_InitKeypad(stc_pcf8574_group_t* pstcGroup, stc_pcf8574_keypad_t* pstcHandle, stc_pcf8574_list_item_t* pstcListItemOut)
+{
+    if ((pstcHandle == NULL) || (pstcHandle->pHandle == NULL) || (pstcListItemOut == NULL))
+    {
+        return ErrorUninitialized;
+    }
+    if ((pstcHandle->portRows == 0) || (pstcHandle->portCols == 0) || ((pstcHandle->portRows & pstcHandle->portCols) != 0) ||
+        ((BitCount(pstcHandle->portRows) * BitCount(pstcHandle->portCols)) > 32))
+    {
+        return ErrorInvalidParameter;
+    }
+    if (pstcHandle->pHandle->pstcBus != NULL)
+    {
+        return ErrorInvalidMode;
+    }
+    Pcf8574_Init(pstcHandle->pHandle,NULL);
+    pstcHandle->u32Keys = 0;
+    pstcHandle->u32Ghosts = 0;
+    pstcHandle->u32Scans = 0;
+    Pcf8574_Write(pstcHandle->pHandle,(pcf8574_port_t)((pstcHandle->pHandle->portStagedValues & ~pstcHandle->portCols) | pstcHandle->portRows));
+    Pcf8574_Read(pstcHandle->pHandle);
+    pstcListItemOut->Handle = pstcHandle;
+    pstcListItemOut->enType = Pcf8574ListTypeKeypad;
+    if (ListItemAdd(GetGroup(pstcGroup),pstcListItemOut) != Ok)
+    {
+        return ErrorBufferFull;
+    }
+    pstcHandle->pHandle->pstcGroup = GetGroup(pstcGroup);
+    return Ok;
+}
+
+/**
+ ** \brief Remove keypad handle from its interrupt group
+ **
+ ** \param pstcHandle Keypad handle
+ **
+ ** \param pstcListItemOut Pointer to list item of the keypad
+ **
+ ** \returns Ok on success
+ */
+en_result_t Pcf8574_DeinitKeypad(stc_pcf8574_keypad_t* pstcHandle, stc_pcf8574_list_item_t* pstcListItemOut)
+{
+    if ((pstcHandle == NULL) || (pstcListItemOut == NULL))
+    {
+        return ErrorUninitialized;
+    }
+    if (pstcListItemOut->pGroup != NULL)
+    {
+        ListItemRemove(pstcListItemOut->pGroup,pstcListItemOut);
+    }
+    pstcHandle->pHandle->pstcGroup = NULL;
+    Pcf8574_TimerStop(&pstcHandle->stcScanTimer);
+    return Ok;
+}
+
+/**
+ ** \brief Execute IRQ handling caused by INT pin for all devices in the default group
+ */
+void Pcf8574_ExtIrqHandle(void)
+{
+    Pcf8574_GroupIrqHandle(NULL);
+}
+
+/**
+ ** \brief Execute IRQ handling caused by the INT line of a group for all devices in the group
+ **
+ ** While the group is locked the IRQ is kept pending and handled by
+ ** Pcf8574_GroupUnlockIrq(), also in deferred mode (see
+ ** Pcf8574_InitEventQueue()), so a locked group has no bus traffic.
+ ** Devices with async bus are read non-blocking and in parallel on all
+ ** buses, the scan finishes in the last transfer completion. An IRQ during
+ ** a running scan restarts the scan when it is done.
+ **
+ ** \param pstcGroup Pointer of group, NULL for the default group
+ */
+void Pcf8574_GroupIrqHandle(stc_pcf8574_group_t* pstcGroup)
+{
+#if PCF8574_REGISTRY_SIZE == 0
+    stc_pcf8574_list_item_t* pstcCurrent;
+#endif
+#if PCF8574_ENABLE_STATS
+    uint32_t u32Start = (uint32_t)PCF8574_STATS_TIMESTAMP();
+#endif
+    pstcGroup = GetGroup(pstcGroup);
+    pstcGroup->u32IrqEpoch++;
+#if PCF8574_REGISTRY_SIZE > 0
+    if (pstcGroup->u32RegCount == 0) return;
+#else
+    pstcCurrent = pstcGroup->pstcListRoot;
+    if (pstcCurrent == NULL) return;
+#endif
+    PCF8574_STATS_INC(pstcGroup,u32Irqs);
+    if (StormIrq(pstcGroup))
+    {
+        return;
+    }
+    GroupScan(pstcGroup);
+#if PCF8574_ENABLE_STATS
+    StatsIsrDuration(&pstcGroup->stcStats,u32Start);
+#endif
+}
+
+/**
+ ** \brief Lock interrupt handling of the default group
+ */
+void Pcf8574_LockIrq(void)
+{
+    Pcf8574_GroupLockIrq(NULL);
+}
+
+/**
+ ** \brief Unlock interrupt handling of the default group
+ */
+void Pcf8574_UnlockIrq(void)
+{
+    Pcf8574_GroupUnlockIrq(NULL);
+}
+
+/**
+ ** \brief Lock interrupt handling of a group
+ **
+ ** \param pstcGroup Pointer of group, NULL for the default group
+ */
+void Pcf8574_GroupLockIrq(stc_pcf8574_group_t* pstcGroup)
+{
+    GetGroup(pstcGroup)->bLock = TRUE;
+}
+
+/**
+ ** \brief Unlock interrupt handling of a group, pending interrupts are handled
+ **
+ ** \param pstcGroup Pointer of group, NULL for the default group
+ */
+void Pcf8574_GroupUnlockIrq(stc_pcf8574_group_t* pstcGroup)
+{
+    pstcGroup = GetGroup(pstcGroup);
+    pstcGroup->bLock = FALSE;
+    if (pstcGroup->bHandleIrq)
+    {
+        Pcf8574_GroupIrqHandle(pstcGroup);
+    }
+}
+
+/**
+ ** \brief Write the staged GPIO changes of all devices of a group
+ **
+ ** Devices with async bus are written non-blocking and in parallel on all
+ ** buses, devices without async bus are written blocking. Devices without
+ ** changes are skipped.
+ **
+ ** \param pstcGroup Pointer of group, NULL for the default group
+ **
+ ** \param pfnDone Called when all devices are written, example: void GroupDone(void* pGroup, en_result_t enResult);
+ **                Can be NULL.
+ **
+ ** \returns Ok if the flush was started
+ */
+en_result_t Pcf8574_GroupFlush(stc_pcf8574_group_t* pstcGroup, pfn_pcf8574_group_done_t pfnDone)
+{
+#if PCF8574_REGISTRY_SIZE > 0
+    uint32_t i;
+#else
+    stc_pcf8574_list_item_t* pstcItem;
+#endif
+    stc_pcf8574_handle_t* pstcDevice;
+    en_result_t enResult;
+    pstcGroup = GetGroup(pstcGroup);
+    PCF8574_ENTER_CRITICAL();
+    if (pstcGroup->u32FlushOutstanding != 0)
+    {
+        PCF8574_EXIT_CRITICAL();
+        return ErrorOperationInProgress;
+    }
+    pstcGroup->u32FlushOutstanding = 1;
+    pstcGroup->enFlushResult = Ok;
+    pstcGroup->pfnFlushDone = pfnDone;
+    PCF8574_EXIT_CRITICAL();
+#if PCF8574_REGISTRY_SIZE > 0
+    for(i = 0;i < pstcGroup->u32RegCount;i++)
+    {
+        pstcDevice = pstcGroup->apstcRegDevices[i];
+#else
+    for(pstcItem = pstcGroup->pstcListRoot;pstcItem != NULL;pstcItem = pstcItem->Next)
+    {
+        pstcDevice = ItemDevice(pstcItem);
+#endif
+        if ((pstcDevice->pstcBus == NULL) ||
+            ((pstcDevice->bOutputValid) && (pstcDevice->portStagedValues == pstcDevice->portOutputValues)))
+        {
+            continue;
+        }
+        PCF8574_ENTER_CRITICAL();
+        pstcGroup->u32FlushOutstanding++;
+        PCF8574_EXIT_CRITICAL();
+        EncodePort(pstcDevice->portStagedValues,pstcDevice->au8WriteData,PortBytes(pstcDevice));
+        enResult = StartWrite(pstcDevice,pstcDevice->au8WriteData,PortBytes(pstcDevice),GroupFlushWriteDone,pstcGroup);
+        if (enResult != Ok)
+        {
+            FlushItemDone(pstcGroup,enResult);
+        }
+    }
+#if PCF8574_REGISTRY_SIZE > 0
+    for(i = 0;i < pstcGroup->u32RegCount;i++)
+    {
+        pstcDevice = pstcGroup->apstcRegDevices[i];
+#else
+    for(pstcItem = pstcGroup->pstcListRoot;pstcItem != NULL;pstcItem = pstcItem->Next)
+    {
+        pstcDevice = ItemDevice(pstcItem);
+#endif
+        if (pstcDevice->pstcBus == NULL)
+        {
+            enResult = Pcf8574_Flush(pstcDevice);
+            if (enResult != Ok)
+            {
+                pstcGroup->enFlushResult = enResult;
+            }
+        }
+    }
+    FlushItemDone(pstcGroup,Ok);
+    return Ok;
+}
+
+/**
+ ** \brief Init deferred mode of a group
+ **
+ ** In deferred mode the interrupt path only samples the ports and records
+ ** the edges in a lock-free single-producer / single-consumer ring buffer.
+ ** The callbacks are called from task context by Pcf8574_ProcessEvents().
+ **
+ ** \param pstcGroup Pointer of group, NULL for the default group
+ **
+ ** \param pastcBuffer Ring buffer, NULL to return to calling callbacks in the interrupt path
+ **
+ ** \param u32Size Number of events in the ring buffer, must be a power of two
+ **
+ ** \returns Ok on success
+ */
+en_result_t Pcf8574_InitEventQueue(stc_pcf8574_group_t* pstcGroup, stc_pcf8574_event_t* pastcBuffer, uint32_t u32Size)
+{
+    pstcGroup = GetGroup(pstcGroup);
+    if ((pastcBuffer != NULL) && ((u32Size == 0) || ((u32Size & (u32Size - 1)) != 0)))
+    {
+        return ErrorInvalidParameter;
+    }
+    pstcGroup->pastcEvents = NULL;
+    PCF8574_MEMORY_BARRIER();
+    pstcGroup->u32EventSize = u32Size;
+    pstcGroup->u32EventHead = 0;
+    pstcGroup->u32EventTail = 0;
+    pstcGroup->u32EventOverflows = 0;
+    PCF8574_MEMORY_BARRIER();
+    pstcGroup->pastcEvents = pastcBuffer;
+    return Ok;
+}
+
+/**
+ ** \brief Dispatch all recorded events of all groups, call from task context
+ */
+void Pcf8574_ProcessEvents(void)
+{
+    stc_pcf8574_group_t* pstcGroup = pstcPcf8574GroupRoot;
+    while(pstcGroup != NULL)
+    {
+        Pcf8574_GroupProcessEvents(pstcGroup);
+        pstcGroup = pstcGroup->Next;
+    }
+}
+
+/**
+ ** \brief Dispatch all recorded events of a group (consumer side), call from task context
+ **
+ ** \param pstcGroup Pointer of group, NULL for the default group
+ **
+ ** \returns number of dispatched events
+ */
+uint32_t Pcf8574_GroupProcessEvents(stc_pcf8574_group_t* pstcGroup)
+{
+    stc_pcf8574_event_t stcEvent;
+    uint32_t u32Tail;
+    uint32_t u32Count = 0;
+    pstcGroup = GetGroup(pstcGroup);
+    if (pstcGroup->pastcEvents == NULL)
+    {
+        return 0;
+    }
+    u32Tail = pstcGroup->u32EventTail;
+    while(u32Tail != pstcGroup->u32EventHead)
+    {
+        PCF8574_MEMORY_BARRIER();
+        stcEvent = pstcGroup->pastcEvents[u32Tail & (pstcGroup->u32EventSize - 1)];
+        PCF8574_MEMORY_BARRIER();
+        u32Tail++;
+        pstcGroup->u32EventTail = u32Tail;
+        DispatchEdges(stcEvent.pHandle,stcEvent.portRiseMask,stcEvent.portFallMask);
+        u32Count++;
+    }
+    return u32Count;
+}
+
+/**
+ ** \brief Get number of events dropped because the ring buffer of a group was full
+ **
+ ** \param pstcGroup Pointer of group, NULL for the default group
+ **
+ ** \returns number of dropped events
+ */
+uint32_t Pcf8574_GetEventOverflows(stc_pcf8574_group_t* pstcGroup)
+{
+    return GetGroup(pstcGroup)->u32EventOverflows;
+}
+
+/**
+ ** \brief Get number of devices of a group serviced later than their maximum latency
+ **
+ ** \param pstcGroup Pointer of group, NULL for the default group
+ **
+ ** \returns number of deadline misses
+ */
+uint32_t Pcf8574_GetDeadlineMisses(stc_pcf8574_group_t* pstcGroup)
+{
+    return GetGroup(pstcGroup)->u32DeadlineMisses;
+}
+
+/**
+ ** \brief Get ms tick counter of Pcf8574_MsTickHandle(), used as event timestamp
+ **
+ ** \returns ms ticks
+ */
+uint32_t Pcf8574_GetTicks(void)
+{
+    return u32Pcf8574Ticks;
+}
+
+/**
+ ** \brief Snapshot of the statistics of a device
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \param pstcStatsOut Snapshot
+ **
+ ** \returns Ok on success, ErrorInvalidMode if built without PCF8574_ENABLE_STATS
+ */
+en_result_t Pcf8574_GetStats(stc_pcf8574_handle_t* pstcHandle, stc_pcf8574_stats_t* pstcStatsOut)
+{
+    if ((pstcHandle == NULL) || (pstcStatsOut == NULL))
+    {
+        return ErrorUninitialized;
+    }
+#if PCF8574_ENABLE_STATS
+    PCF8574_ENTER_CRITICAL();
+    memcpy(pstcStatsOut,&pstcHandle->stcStats,sizeof(stc_pcf8574_stats_t));
+    PCF8574_EXIT_CRITICAL();
+    return Ok;
+#else
+    memset(pstcStatsOut,0,sizeof(stc_pcf8574_stats_t));
+    return ErrorInvalidMode;
+#endif
+}
+
+/**
+ ** \brief Reset the statistics of a device
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \returns Ok on success, ErrorInvalidMode if built without PCF8574_ENABLE_STATS
+ */
+en_result_t Pcf8574_ResetStats(stc_pcf8574_handle_t* pstcHandle)
+{
+    if (pstcHandle == NULL)
+    {
+        return ErrorUninitialized;
+    }
+#if PCF8574_ENABLE_STATS
+    PCF8574_ENTER_CRITICAL();
+    memset(&pstcHandle->stcStats,0,sizeof(stc_pcf8574_stats_t));
+    PCF8574_EXIT_CRITICAL();
+    return Ok;
+#else
+    return ErrorInvalidMode;
+#endif
+}
+
+/**
+ ** \brief Snapshot of the statistics of a group
+ **
+ ** \param pstcGroup Pointer of group, NULL for the default group
+ **
+ ** \param pstcStatsOut Snapshot
+ **
+ ** \returns Ok on success, ErrorInvalidMode if built without PCF8574_ENABLE_STATS
+ */
+en_result_t Pcf8574_GroupGetStats(stc_pcf8574_group_t* pstcGroup, stc_pcf8574_stats_t* pstcStatsOut)
+{
+    if (pstcStatsOut == NULL)
+    {
+        return ErrorUninitialized;
+    }
+#if PCF8574_ENABLE_STATS
+    pstcGroup = GetGroup(pstcGroup);
+    PCF8574_ENTER_CRITICAL();
+    memcpy(pstcStatsOut,&pstcGroup->stcStats,sizeof(stc_pcf8574_stats_t));
+    PCF8574_EXIT_CRITICAL();
+    return Ok;
+#else
+    (void)pstcGroup;
+    memset(pstcStatsOut,0,sizeof(stc_pcf8574_stats_t));
+    return ErrorInvalidMode;
+#endif
+}
+
+/**
+ ** \brief Reset the statistics of a group
+ **
+ ** \param pstcGroup Pointer of group, NULL for the default group
+ **
+ ** \returns Ok on success, ErrorInvalidMode if built without PCF8574_ENABLE_STATS
+ */
+en_result_t Pcf8574_GroupResetStats(stc_pcf8574_group_t* pstcGroup)
+{
+#if PCF8574_ENABLE_STATS
+    pstcGroup = GetGroup(pstcGroup);
+    PCF8574_ENTER_CRITICAL();
+    memset(&pstcGroup->stcStats,0,sizeof(stc_pcf8574_stats_t));
+    PCF8574_EXIT_CRITICAL();
+    return Ok;
+#else
+    (void)pstcGroup;
+    return ErrorInvalidMode;
+#endif
+}
+
+/**
+ ** \brief Start (or restart) a timer of the timer wheel
+ **
+ ** Timers are hashed into PCF8574_TIMER_WHEEL_SIZE slots by their expiry
+ ** tick, Pcf8574_MsTickHandle() only visits the slot of the current tick.
+ ** The expired callback is called from Pcf8574_MsTickHandle(), the timer
+ ** may be restarted from the callback.
+ **
+ ** \param pstcTimer Pointer of timer
+ **
+ ** \param u32Delay Delay in ms ticks, 0 is handled as 1
+ **
+ ** \param pfnExpired Expired callback
+ **
+ ** \param pHandle Handle for the callback
+ **
+ ** \param pUser User data for the callback
+ **
+ ** \returns Ok on success
+ */
+en_result_t Pcf8574_TimerStart(stc_pcf8574_timer_t* pstcTimer, uint32_t u32Delay, pfn_pcf8574_timer_t pfnExpired, void* pHandle, void* pUser)
+{
+    stc_pcf8574_timer_t** ppstcSlot;
+    if ((pstcTimer == NULL) || (pfnExpired == NULL))
+    {
+        return ErrorUninitialized;
+    }
+    if (u32Delay == 0)
+    {
+        u32Delay = 1;
+    }
+    Pcf8574_TimerStop(pstcTimer);
+    PCF8574_ENTER_CRITICAL();
+    pstcTimer->pfnExpired = pfnExpired;
+    pstcTimer->pHandle = pHandle;
+    pstcTimer->pUser = pUser;
+    pstcTimer->u32Expiry = u32Pcf8574Ticks + u32Delay;
+    ppstcSlot = &apstcPcf8574TimerWheel[pstcTimer->u32Expiry & (PCF8574_TIMER_WHEEL_SIZE - 1)];
+    pstcTimer->Next = *ppstcSlot;
+    *ppstcSlot = pstcTimer;
+    pstcTimer->bActive = TRUE;
+    PCF8574_EXIT_CRITICAL();
+    return Ok;
+}
+
+/**
+ ** \brief Stop a timer of the timer wheel
+ **
+ ** \param pstcTimer Pointer of timer
+ */
+void Pcf8574_TimerStop(stc_pcf8574_timer_t* pstcTimer)
+{
+    stc_pcf8574_timer_t** ppstcCurrent;
+    if ((pstcTimer == NULL) || (!pstcTimer->bActive))
+    {
+        return;
+    }
+    PCF8574_ENTER_CRITICAL();
+    ppstcCurrent = &apstcPcf8574TimerWheel[pstcTimer->u32Expiry & (PCF8574_TIMER_WHEEL_SIZE - 1)];
+    while(*ppstcCurrent != NULL)
+    {
+        if (*ppstcCurrent == pstcTimer)
+        {
+            *ppstcCurrent = pstcTimer->Next;
+            break;
+        }
+        ppstcCurrent = &((*ppstcCurrent)->Next);
+    }
+    pstcTimer->Next = NULL;
+    pstcTimer->bActive = FALSE;
+    PCF8574_EXIT_CRITICAL();
+}
+
+/**
+ ** \brief Start a blink pattern at a GPIO
+ **
+ ** The GPIO is switched on for u32OnMs and off for u32OffMs, starting with
+ ** the next ms tick. Patterns started in the same tick run in phase, all
+ ** GPIO changes of a device due in the same tick are merged into one write
+ ** at the end of Pcf8574_MsTickHandle(), ticks without changes cause no
+ ** transfer. Other GPIOs keep their staged values.
+ **
+ ** \param pstcSeq Sequencer of the GPIO
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \param u8Pin GPIO
+ **
+ ** \param bActiveLow TRUE = GPIO low while on
+ **
+ ** \param u32OnMs On time in ms
+ **
+ ** \param u32OffMs Off time in ms, may be 0 only for a single period
+ **
+ ** \param u32Repeat Number of periods, 0 = endless, the GPIO stays off afterwards
+ **
+ ** \returns Ok on success
+ */
+en_result_t Pcf8574_SeqStart(stc_pcf8574_seq_t* pstcSeq, stc_pcf8574_handle_t* pstcHandle, uint8_t u8Pin, boolean_t bActiveLow, uint32_t u32OnMs, uint32_t u32OffMs, uint32_t u32Repeat)
+{
+    if ((pstcSeq == NULL) || (pstcHandle == NULL))
+    {
+        return ErrorUninitialized;
+    }
+    if ((u8Pin >= PortBits(pstcHandle)) || (u32OnMs == 0) || ((u32OffMs == 0) && (u32Repeat != 1)))
+    {
+        return ErrorInvalidParameter;
+    }
+    Pcf8574_TimerStop(&pstcSeq->stcTimer);
+    pstcSeq->pHandle = pstcHandle;
+    pstcSeq->u8Pin = u8Pin;
+    pstcSeq->bActiveLow = bActiveLow;
+    pstcSeq->bOn = FALSE;
+    pstcSeq->u32OnMs = u32OnMs;
+    pstcSeq->u32OffMs = u32OffMs;
+    pstcSeq->u32Remain = u32Repeat;
+    return Pcf8574_TimerStart(&pstcSeq->stcTimer,1,SeqTimerExpired,pstcSeq,NULL);
+}
+
+/**
+ ** \brief Switch a GPIO on for u32Ms once (one-shot pulse)
+ **
+ ** \param pstcSeq Sequencer of the GPIO
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \param u8Pin GPIO
+ **
+ ** \param bActiveLow TRUE = GPIO low while on
+ **
+ ** \param u32Ms Pulse length in ms
+ **
+ ** \returns Ok on success
+ */
+en_result_t Pcf8574_SeqPulse(stc_pcf8574_seq_t* pstcSeq, stc_pcf8574_handle_t* pstcHandle, uint8_t u8Pin, boolean_t bActiveLow, uint32_t u32Ms)
+{
+    return Pcf8574_SeqStart(pstcSeq,pstcHandle,u8Pin,bActiveLow,u32Ms,0,1);
+}
+
+/**
+ ** \brief Low-rate software PWM at a GPIO
+ **
+ ** The resolution is one ms tick, a duty cycle of 0 or 100 percent sets the
+ ** GPIO statically without timer.
+ **
+ ** \param pstcSeq Sequencer of the GPIO
+ **
+ ** \param pstcHandle Pointer of handle
+ **
+ ** \param u8Pin GPIO
+ **
+ ** \param bActiveLow TRUE = GPIO low while on
+ **
+ ** \param u32PeriodMs PWM period in ms
+ **
+ ** \param u8DutyPercent On time in percent of the period
+ **
+ ** \returns Ok on success
+ */
+en_result_t Pcf8574_SeqPwm(stc_pcf8574_seq_t* pstcSeq, stc_pcf8574_handle_t* pstcHandle, uint8_t u8Pin, boolean_t bActiveLow, uint32_t u32PeriodMs, uint8_t u8DutyPercent)
+{
+    uint32_t u32OnMs;
+    if ((pstcSeq == NULL) || (pstcHandle == NULL))
+    {
+        return ErrorUninitialized;
+    }
+    if ((u8Pin >= PortBits(pstcHandle)) || (u32PeriodMs == 0) || (u8DutyPercent > 100))
+    {
+        return ErrorInvalidParameter;
+    }
+    u32OnMs = (u32PeriodMs * u8DutyPercent + 50) / 100;
+    if ((u32OnMs == 0) || (u32OnMs >= u32PeriodMs))
+    {
+        Pcf8574_TimerStop(&pstcSeq->stcTimer);
+        pstcSeq->pHandle = pstcHandle;
+        pstcSeq->u8Pin = u8Pin;
+        pstcSeq->bActiveLow = bActiveLow;
+        SeqSetLevel(pstcSeq,(boolean_t)(u32OnMs != 0));
+        return Ok;
+    }
+    return Pcf8574_SeqStart(pstcSeq,pstcHandle,u8Pin,bActiveLow,u32OnMs,u32PeriodMs - u32OnMs,0);
+}
+
+/**
+ ** \brief Stop the pattern of a GPIO, the GPIO is switched off with the next ms tick
+ **
+ ** \param pstcSeq Sequencer of the GPIO
+ **
+ ** \returns Ok on success
+ */
+en_result_t Pcf8574_SeqStop(stc_pcf8574_seq_t* pstcSeq)
+{
+    if ((pstcSeq == NULL) || (pstcSeq->pHandle == NULL))
+    {
+        return ErrorUninitialized;
+    }
+    Pcf8574_TimerStop(&pstcSeq->stcTimer);
+    SeqSetLevel(pstcSeq,FALSE);
+    return Ok;
+}
+
+/**
+ ** \brief Called every ms for example via SysStick IRQ
+ **
+ ** Only the timers of the current timer wheel slot are visited, outputs
+ ** changed by sequencers are written once per device afterwards.
  */
 void Pcf8574_MsTickHandle(void)
 {
-    stc_pcf8574_list_item_t* pstcCurrent = pstcPcf8574ListRoot;
-    if (pstcPcf8574ListRoot == NULL) return;
-    
-    while(pstcCurrent != NULL)
+    stc_pcf8574_timer_t** ppstcCurrent;
+    stc_pcf8574_timer_t* pstcExpired;
+    uint32_t u32Now = ++u32Pcf8574Ticks;
+    do
     {
-        if (pstcCurrent->enType == Pcf8574ListTypeEncoder)
+        pstcExpired = NULL;
+        PCF8574_ENTER_CRITICAL();
+        ppstcCurrent = &apstcPcf8574TimerWheel[u32Now & (PCF8574_TIMER_WHEEL_SIZE - 1)];
+        while(*ppstcCurrent != NULL)
         {
-            if (((stc_pcf8574_rotaryencoder_t*)pstcCurrent->Handle)->bButton)
+            if ((*ppstcCurrent)->u32Expiry == u32Now)
             {
-                ((stc_pcf8574_rotaryencoder_t*)pstcCurrent->Handle)->u32LastPressedTime++;
+                pstcExpired = *ppstcCurrent;
+                *ppstcCurrent = pstcExpired->Next;
+                pstcExpired->Next = NULL;
+                pstcExpired->bActive = FALSE;
+                break;
             }
+            ppstcCurrent = &((*ppstcCurrent)->Next);
         }
-        pstcCurrent = pstcCurrent->Next;
+        PCF8574_EXIT_CRITICAL();
+        if (pstcExpired != NULL)
+        {
+            pstcExpired->pfnExpired(pstcExpired);
+        }
+    } while(pstcExpired != NULL);
+    if (pstcPcf8574SeqPending != NULL)
+    {
+        SeqFlush();
     }
 }
 
@@ -70,23 +70,16 @@ extern "C"
  **
  ** int I2CWrite(void* pHandle, uint32_t u32Address, uint8_t* pu8Data, uint32_t u32Len)
  ** {
- **     HAL_I2cWrite(pHandle,u32Address,pu8Data,u32Len);
+ **     return HAL_I2cWrite(pHandle,u32Address,pu8Data,u32Len); //0 on success
  ** }
  ** 
  ** int I2CRead(void* pHandle, uint32_t u32Address, uint8_t* pu8Data, uint32_t u32Len)
  ** {
- **     HAL_I2cRead(pHandle,u32Address,pu8Data,u32Len);
+ **     return HAL_I2cRead(pHandle,u32Address,pu8Data,u32Len);  //0 on success
  ** }
  **
  ** stc_pcf8574_list_item_t stcPcf8574ListItm;
- ** stc_pcf8574_handle_t stcPcf8574 =
- ** {
- **     I2C0,        //pI2cHandle;
- **     (0x70>>1),   //u32Address;
- **     0,           //uint8_t u8CurrentValues;
- **     I2CRead,     //pfnRead;
- **     I2CWrite     //pfnWrite;
- ** };
+ ** stc_pcf8574_handle_t stcPcf8574;
  ** 
  ** void GpioCallback(void)
  ** {
@@ -104,7 +97,11 @@ extern "C"
  **     Board_Init();        //Init I2C
  **
  **
- **     PCF8575_ZERO_CALLBACKS(&stcPcf8574);          //zero initialize all callbacks
+ **     PCF8574_CONFIG_INIT(stcPcf8574);              //zero initialize the handle, required before Pcf8574_Init()
+ **     stcPcf8574.pI2cHandle = I2C0;
+ **     stcPcf8574.u32Address = (0x70>>1);
+ **     stcPcf8574.pfnRead = I2CRead;
+ **     stcPcf8574.pfnWrite = I2CWrite;
  **     Pcf8574_Init(&stcPcf8574,&stcPcf8574ListItm); //init PCF8574
  **
  **     //Optional: Register pin connected to INT as falling edge interrupt at MCUs HAL
@@ -117,6 +114,10 @@ extern "C"
  **
  **     Pcf8574_Write(&stcPcf8574,0xFF);              //write 0xFF to all GPIOs
  **     u8Data = Pcf8574_Read(&stcPcf8574);           //read GPIOs into u8Data
+ **
+ **     Pcf8574_ClearPin(&stcPcf8574,4);              //stage GPIO4 low
+ **     Pcf8574_TogglePins(&stcPcf8574,0x03);         //stage toggle of GPIO0 and GPIO1
+ **     Pcf8574_Flush(&stcPcf8574);                   //one write for all staged changes
  **     while(1)
  **     {
  **         //main applicaton
@@ -143,7 +144,95 @@ extern "C"
  */
 
  #define PCF8574_CONFIG_INIT(x) memset(&(x),0,sizeof((x)))
- #define PCF8575_ZERO_CALLBACKS(pHandle) memset(&((pHandle)->astcCallbacks[0]),0,sizeof(((pHandle)->astcCallbacks)))
+ /** Widest supported port in bits (8 for PCF8574 only, 16 for PCF8575, up to 32), sets the size of pcf8574_port_t,
+     PCF8575 users build with -DPCF8574_MAX_PORT_BITS=16 */
+ #if !defined(PCF8574_MAX_PORT_BITS)
+ #define PCF8574_MAX_PORT_BITS 8
+ #endif
+ #define PCF8574_MAX_PORT_BYTES ((PCF8574_MAX_PORT_BITS + 7) / 8)
+
+ /** Maximum number of samples taken by one burst read */
+ #if !defined(PCF8574_MAX_BURST_SAMPLES)
+ #define PCF8574_MAX_BURST_SAMPLES 8
+ #endif
+
+ /** Memory barrier between ring buffer data and index accesses, default is a full barrier on GCC compatible compilers */
+ #if !defined(PCF8574_MEMORY_BARRIER)
+ #if defined(__GNUC__) || defined(__clang__)
+ #define PCF8574_MEMORY_BARRIER() __sync_synchronize()
+ #else
+ #define PCF8574_MEMORY_BARRIER()
+ #endif
+ #endif
+
+ /** Encoder velocity and acceleration are reset after this time without step in ms */
+ #if !defined(PCF8574_ENCODER_IDLE_MS)
+ #define PCF8574_ENCODER_IDLE_MS 200
+ #endif
+
+ /** Devices per group in a statically sized struct-of-arrays registry instead of the linked list, 0 = linked list */
+ #if !defined(PCF8574_REGISTRY_SIZE)
+ #define PCF8574_REGISTRY_SIZE 0
+ #endif
+
+ /** Keypad scan delay after INT in ms, key bounce within this time causes no additional scan, 0 = scan in the IRQ handling */
+ #if !defined(PCF8574_KEYPAD_DEBOUNCE_MS)
+ #define PCF8574_KEYPAD_DEBOUNCE_MS 5
+ #endif
+
+ /** Keypad rescan interval in ms while keys are held, more keys pressed or released in an active row raise no INT */
+ #if !defined(PCF8574_KEYPAD_RESCAN_MS)
+ #if PCF8574_KEYPAD_DEBOUNCE_MS > 0
+ #define PCF8574_KEYPAD_RESCAN_MS PCF8574_KEYPAD_DEBOUNCE_MS
+ #else
+ #define PCF8574_KEYPAD_RESCAN_MS 1
+ #endif
+ #endif
+
+ /** Number of timer wheel slots, power of two */
+ #if !defined(PCF8574_TIMER_WHEEL_SIZE)
+ #define PCF8574_TIMER_WHEEL_SIZE 32
+ #endif
+
+ /** Maximum messages of one vectored transfer (pfnTransfer), devices of a scan are read in batches of this size */
+ #if !defined(PCF8574_TRANSFER_MAX_MSGS)
+ #define PCF8574_TRANSFER_MAX_MSGS 8
+ #endif
+ /** Flag of stc_pcf8574_i2c_msg_t: read message, otherwise write */
+ #define PCF8574_I2C_M_RD 0x0001
+
+ /** Window of the interrupt storm detection in ms, also the quiet time before a polled group returns to IRQ mode */
+ #if !defined(PCF8574_STORM_WINDOW_MS)
+ #define PCF8574_STORM_WINDOW_MS 100
+ #endif
+
+ /** Runtime statistics per device and group, see Pcf8574_GetStats() */
+ #if !defined(PCF8574_ENABLE_STATS)
+ #define PCF8574_ENABLE_STATS 0
+ #endif
+ /** Bins of the log2 ISR duration histogram */
+ #if !defined(PCF8574_STATS_HISTOGRAM_BINS)
+ #define PCF8574_STATS_HISTOGRAM_BINS 16
+ #endif
+ /** Time stamp for ISR durations, default is the ms tick, override with a cycle counter (e.g. DWT->CYCCNT) */
+ #if !defined(PCF8574_STATS_TIMESTAMP)
+ #define PCF8574_STATS_TIMESTAMP() Pcf8574_GetTicks()
+ #endif
+
+ /** Critical section around the async transfer queues, override for your platform (e.g. __disable_irq() / __enable_irq()) */
+ #if !defined(PCF8574_ENTER_CRITICAL)
+ #define PCF8574_ENTER_CRITICAL()
+ #endif
+ #if !defined(PCF8574_EXIT_CRITICAL)
+ #define PCF8574_EXIT_CRITICAL()
+ #endif
+
+ #define PCF8575_ZERO_CALLBACKS(pHandle) do { \
+     memset(&((pHandle)->astcCallbacks[0]),0,sizeof(((pHandle)->astcCallbacks))); \
+     (pHandle)->portRiseMask = 0; \
+     (pHandle)->portFallMask = 0; \
+     (pHandle)->pfnPortCallback = NULL; \
+ } while(0)
 
 /**
  *******************************************************************************
@@ -151,10 +240,22 @@ extern "C"
  *******************************************************************************
  */
 
+/**
+ ** \brief Port value, one bit per GPIO (P0..P7 in the low byte, P10..P17 of a PCF8575 in the next byte)
+ */
+#if PCF8574_MAX_PORT_BITS <= 8
+typedef uint8_t pcf8574_port_t;
+#elif PCF8574_MAX_PORT_BITS <= 16
+typedef uint16_t pcf8574_port_t;
+#else
+typedef uint32_t pcf8574_port_t;
+#endif
+
 typedef enum en_pcf8574_list_item_type
 {
   Pcf8574ListTypeNone = 0,
-  Pcf8574ListTypeEncoder = 1
+  Pcf8574ListTypeEncoder = 1,
+  Pcf8574ListTypeKeypad = 2
 } en_pcf8574_list_item_type_t;
 
 
@@ -163,23 +264,140 @@ typedef struct stc_pcf8574_list_item
   void* Handle;
   en_pcf8574_list_item_type_t enType;
   void* Next;
+  void* pGroup;
+  uint8_t u8Priority;         ///< scan order in the group, higher first, equal in order of adding, see Pcf8574_SetPriority()
+  uint32_t u32MaxLatencyMs;   ///< maximum time from IRQ to service in ms, 0 = no deadline
+  uint32_t u32DeadlineMisses; ///< services later than u32MaxLatencyMs
+#if PCF8574_REGISTRY_SIZE > 0
+  uint16_t u16Slot;           ///< index in the registry of the group
+#endif
 } stc_pcf8574_list_item_t;
 
 /**
- ** \brief I2C read function
+ ** \brief I2C read function, returns 0 on success
  */
 typedef int (*pfn_pcf8574_i2c_read_t)  (void* pHandle, uint32_t u32Address, uint8_t* pu8Data, uint32_t u32Len); 
 
 /**
- ** \brief I2C write function
+ ** \brief I2C write function, returns 0 on success
  */
 typedef int (*pfn_pcf8574_i2c_write_t)  (void* pHandle, uint32_t u32Address, uint8_t* pu8Data, uint32_t u32Len); 
 
+/**
+ ** \brief Message of a vectored transfer (like struct i2c_msg of Linux I2C_RDWR)
+ */
+typedef struct stc_pcf8574_i2c_msg
+{
+    uint32_t u32Address;      ///< 7-bit address
+    uint16_t u16Flags;        ///< PCF8574_I2C_M_RD for reads
+    uint16_t u16Len;
+    uint8_t* pu8Data;
+} stc_pcf8574_i2c_msg_t;
+
+/**
+ ** \brief Vectored I2C transfer function, returns 0 on success
+ **
+ ** All messages are sent as one combined transaction: a repeated start
+ ** between the messages and one stop at the end.
+ */
+typedef int (*pfn_pcf8574_i2c_transfer_t)  (void* pHandle, stc_pcf8574_i2c_msg_t* pastcMsgs, uint32_t u32Count);
+
+/**
+ ** \brief Async transfer direction enumeration
+ */
+typedef enum en_pcf8574_xfer_dir
+{
+   Pcf8574XferWrite = 0,
+   Pcf8574XferRead = 1
+} en_pcf8574_xfer_dir_t;
+
+/**
+ ** \brief Async transfer, queued at a bus and passed to the async transport
+ */
+typedef struct stc_pcf8574_xfer
+{
+    en_pcf8574_xfer_dir_t enDir;
+    uint32_t u32Address;
+    uint8_t* pu8Data;
+    uint32_t u32Len;
+    void (*pfnDone)(struct stc_pcf8574_xfer* pstcXfer, int iResult); ///< internal completion handler
+    void* pBus;               ///< bus the transfer is queued at
+    void* pHandle;            ///< device handle owning the transfer
+    void* pUser;              ///< internal use
+    volatile boolean_t bBusy;
+    void* Next;
+} stc_pcf8574_xfer_t;
+
+/**
+ ** \brief Async I2C transport, starts a transfer and returns 0 if started.
+ **        The transport calls Pcf8574_XferComplete() when the transfer has finished.
+ */
+typedef int (*pfn_pcf8574_i2c_submit_t)  (void* pHandle, stc_pcf8574_xfer_t* pstcXfer); 
+
+/**
+ ** \brief Async I2C bus, transfers of all devices on the bus are queued and executed one after another
+ */
+typedef struct stc_pcf8574_bus
+{
+    void* pI2cHandle;
+    pfn_pcf8574_i2c_submit_t pfnSubmit;
+    stc_pcf8574_xfer_t* pstcHead;   ///< transfer in progress
+    stc_pcf8574_xfer_t* pstcTail;
+} stc_pcf8574_bus_t;
+
+/**
+ ** \brief Async operation done callback
+ */
+typedef void (*pfn_pcf8574_done_t)  (void* pHandle, en_result_t enResult); 
+
+/**
+ ** \brief Group operation done callback
+ */
+typedef void (*pfn_pcf8574_group_done_t)  (void* pGroup, en_result_t enResult); 
+
+/**
+ ** \brief INT line read function of a group, returns TRUE while INT is asserted (low)
+ */
+typedef boolean_t (*pfn_pcf8574_int_read_t)  (void* pHandle);
+
+/**
+ ** \brief Interrupt mask function of a group, bMask = TRUE disables the MCU interrupt of the INT line
+ */
+typedef void (*pfn_pcf8574_irq_mask_t)  (void* pHandle, boolean_t bMask);
+
+/**
+ ** \brief Timer of the timer wheel, see Pcf8574_TimerStart()
+ */
+typedef struct stc_pcf8574_timer
+{
+    void (*pfnExpired)(struct stc_pcf8574_timer* pstcTimer);
+    void* pHandle;
+    void* pUser;
+    uint32_t u32Expiry;       ///< ms tick of expiry
+    volatile boolean_t bActive;
+    struct stc_pcf8574_timer* Next;
+} stc_pcf8574_timer_t;
+
+/**
+ ** \brief Timer expired callback
+ */
+typedef void (*pfn_pcf8574_timer_t)  (stc_pcf8574_timer_t* pstcTimer); 
+
 /**
  ** \brief Pin change callback
  */
 typedef void (*pfn_pcf8574_callback_t)  (void* pHandle, uint8_t u8Pin); 
 
+/**
+ ** \brief Key callback of a keypad, u8Key = row * columns + column
+ */
+typedef void (*pfn_pcf8574_key_callback_t)  (void* pHandle, uint8_t u8Key, boolean_t bPressed); 
+
+/**
+ ** \brief Port change callback, called once per IRQ handling with all rising and falling GPIOs
+ */
+typedef void (*pfn_pcf8574_port_callback_t)  (void* pHandle, pcf8574_port_t portRiseMask, pcf8574_port_t portFallMask); 
+
 /**
  ** \brief IRQ trigger type enumeration
  */
@@ -191,6 +409,26 @@ typedef enum en_pcf8574_irq_trigger
    Pcf8574RisingFallingEdge
 } en_pcf8574_irq_trigger_t;
 
+/**
+ ** \brief Burst read filter enumeration
+ */
+typedef enum en_pcf8574_filter
+{
+   Pcf8574FilterNone = 0,       ///< use the last sample of the burst
+   Pcf8574FilterMajority,       ///< bitwise majority of all samples, ties keep the previous value
+   Pcf8574FilterConsecutive     ///< bits change only if all samples agree
+} en_pcf8574_filter_t;
+
+/**
+ ** \brief Rotary encoder decoding enumeration
+ */
+typedef enum en_pcf8574_quad_mode
+{
+   Pcf8574Quad1x = 0,           ///< one count per detent on the falling edge of A
+   Pcf8574Quad2x,               ///< counts on both edges of A, table driven
+   Pcf8574Quad4x                ///< counts on every edge of A and B, table driven
+} en_pcf8574_quad_mode_t;
+
 /**
  ** \brief IRQ struct
  */
@@ -200,6 +438,40 @@ typedef struct stc_pcf8574_irq
     pfn_pcf8574_callback_t pfnCallback;
 } stc_pcf8574_irq_t;
 
+/**
+ ** \brief Runtime statistics of a device or a group (PCF8574_ENABLE_STATS)
+ **
+ ** Devices count transfers, IRQ samples, callbacks and ISR durations of
+ ** their IRQ handling. Groups count IRQs, scans without change, event
+ ** ring overflows and ISR durations of Pcf8574_GroupIrqHandle().
+ */
+typedef struct stc_pcf8574_stats
+{
+    uint32_t u32Reads;        ///< read transfers
+    uint32_t u32Writes;       ///< write transfers
+    uint32_t u32BytesRead;
+    uint32_t u32BytesWritten;
+    uint32_t u32ReadErrors;   ///< failed read transfers
+    uint32_t u32WriteErrors;  ///< failed write transfers
+    uint32_t u32Irqs;         ///< device: IRQ samples, group: IRQ handlings
+    uint32_t u32Spurious;     ///< device: IRQ samples without change, group: scans without change on any device
+    uint32_t u32Callbacks;    ///< callbacks fired
+    uint32_t u32Overflows;    ///< events dropped because the ring buffer was full
+    uint32_t au32IsrHistogram[PCF8574_STATS_HISTOGRAM_BINS]; ///< bin 0: duration 0, bin n: duration 2^(n-1)..2^n-1, last bin: longer
+} stc_pcf8574_stats_t;
+
+/**
+ ** \brief Bus bandwidth budget of the poller (token bucket), shared by all polled devices of one bus
+ */
+typedef struct stc_pcf8574_poll_budget
+{
+    uint32_t u32BytesPerSecond; ///< refill rate of the bucket, 0 = unlimited
+    uint32_t u32Burst;        ///< bucket size in bytes
+    uint32_t u32Tokens;       ///< available bytes in 1/1000 byte
+    uint32_t u32LastRefill;   ///< ms tick of the last refill
+    uint32_t u32Deferred;     ///< polls deferred because the budget was exhausted
+} stc_pcf8574_poll_budget_t;
+
 /**
  ** \brief PCF8574 handle
  */
@@ -207,12 +479,132 @@ typedef struct stc_pcf8574_handle
 {
     void* pI2cHandle;
     uint32_t u32Address;
-    uint8_t u8CurrentValues;
+    pcf8574_port_t portCurrentValues;
     pfn_pcf8574_i2c_read_t pfnRead;
     pfn_pcf8574_i2c_write_t pfnWrite;
-    stc_pcf8574_irq_t astcCallbacks[8];
+    stc_pcf8574_irq_t astcCallbacks[PCF8574_MAX_PORT_BITS];
+    pcf8574_port_t portOutputValues;   ///< output value latched in the device by the last write
+    pcf8574_port_t portStagedValues;   ///< output value staged by the pin API, written by Pcf8574_Flush()
+    boolean_t bOutputValid;   ///< TRUE if portOutputValues reflects the device latch
+    uint32_t u32MaxTransferLen; ///< maximum bytes per write transfer for streams, 0 = unlimited
+    uint8_t u8BurstSamples;   ///< samples per IRQ read (burst read), 0 or 1 = single read
+    en_pcf8574_filter_t enBurstFilter; ///< filter applied to burst samples
+    pcf8574_port_t portRiseMask;       ///< GPIOs with a rising edge callback, maintained by Pcf8574_InitCallback()
+    pcf8574_port_t portFallMask;       ///< GPIOs with a falling edge callback, maintained by Pcf8574_InitCallback()
+    pfn_pcf8574_port_callback_t pfnPortCallback; ///< optional callback for all edges of the port
+    stc_pcf8574_bus_t* pstcBus;   ///< optional async bus, NULL = blocking transfers via pfnRead / pfnWrite
+    stc_pcf8574_xfer_t stcXferRead;
+    stc_pcf8574_xfer_t stcXferWrite;
+    uint8_t au8ReadData[PCF8574_MAX_BURST_SAMPLES * PCF8574_MAX_PORT_BYTES];
+    uint8_t au8WriteData[PCF8574_MAX_PORT_BYTES];
+    const uint8_t* pu8StreamNext;
+    uint32_t u32StreamRemain;
+    pfn_pcf8574_done_t pfnReadDone;
+    pfn_pcf8574_done_t pfnWriteDone;
+    uint8_t u8PortBits;       ///< port width in bits, 0 or 8 = PCF8574, 16 = PCF8575
+    volatile boolean_t bDebounce; ///< TRUE = callbacks are called for debounced GPIOs from Pcf8574_MsTickHandle(), set by Pcf8574_InitDebounce()
+    pcf8574_port_t portDebounced;      ///< debounced port value
+    pcf8574_port_t portDebounceCnt0;   ///< bit 0 of the per GPIO debounce counters
+    pcf8574_port_t portDebounceCnt1;   ///< bit 1 of the per GPIO debounce counters
+    stc_pcf8574_timer_t stcDebounceTimer; ///< runs while debounced GPIOs are unsettled
+#if PCF8574_ENABLE_STATS
+    stc_pcf8574_stats_t stcStats;
+#endif
+    stc_pcf8574_timer_t stcPollTimer;  ///< runs while the device is polled, see Pcf8574_InitPoll()
+    stc_pcf8574_poll_budget_t* pstcPollBudget; ///< optional bandwidth budget of the poller
+    uint32_t u32PollMinMs;    ///< poll interval after a change
+    uint32_t u32PollMaxMs;    ///< poll interval when idle, 0 = polling off
+    uint32_t u32PollInterval; ///< current poll interval in ms
+    pcf8574_port_t portPollPrevious;   ///< port value before the last async read, edges not delivered yet
+    volatile boolean_t bSeqPending;    ///< staged values changed by the sequencer, written at the end of the ms tick
+    struct stc_pcf8574_handle* pstcSeqNext; ///< next device with pending sequencer changes
+    pfn_pcf8574_i2c_transfer_t pfnTransfer; ///< optional vectored transfer, consecutive devices of a group with the same pI2cHandle are read in one transaction
+    struct stc_pcf8574_group* pstcCacheGroup; ///< group whose INT line gates Pcf8574_Read(), NULL = cached reads off
+    struct stc_pcf8574_group* pstcGroup; ///< group the device is listed in, maintained by the init functions, NULL = not listed
+    volatile uint32_t u32ShadowSeq;    ///< seqlock of the shadow, odd while it is updated
+    volatile pcf8574_port_t portShadow; ///< port value of the last Pcf8574_Read() from the bus
+    volatile uint32_t u32ShadowEpoch;  ///< u32IrqEpoch of the group when the shadow was read
+    volatile boolean_t bShadowValid;   ///< FALSE after writes to the device
+    uint32_t u32CacheHits;    ///< Pcf8574_Read() calls answered from the shadow
+    uint32_t u32CacheMisses;  ///< Pcf8574_Read() calls that went to the bus
 } stc_pcf8574_handle_t;
 
+/**
+ ** \brief Deferred IRQ event, recorded by the interrupt path and dispatched by Pcf8574_ProcessEvents()
+ */
+typedef struct stc_pcf8574_event
+{
+    stc_pcf8574_handle_t* pHandle;
+    pcf8574_port_t portRiseMask;
+    pcf8574_port_t portFallMask;
+    uint32_t u32Timestamp;    ///< ms tick of Pcf8574_MsTickHandle() when the port was sampled
+} stc_pcf8574_event_t;
+
+/**
+ ** \brief Result of Pcf8574_ReadAll()
+ */
+typedef struct stc_pcf8574_snapshot
+{
+    uint32_t u32Timestamp;    ///< ms tick when the image was read
+    uint32_t u32Count;        ///< devices in the image
+    uint32_t u32Transfers;    ///< transactions used, 1 = all devices sampled in one combined transfer
+    uint32_t u32Errors;       ///< devices that failed, their last value is in the image
+} stc_pcf8574_snapshot_t;
+
+/**
+ ** \brief Interrupt group, one group per INT line with its own device list
+ */
+typedef struct stc_pcf8574_group
+{
+    stc_pcf8574_list_item_t* pstcListRoot;
+    volatile boolean_t bLock;
+    volatile boolean_t bHandleIrq;
+    void* Next;
+    stc_pcf8574_event_t* pastcEvents;   ///< event ring buffer for deferred mode, NULL = callbacks run in the interrupt path
+    uint32_t u32EventSize;              ///< number of events in the ring buffer, power of two
+    volatile uint32_t u32EventHead;     ///< written by the interrupt path only
+    volatile uint32_t u32EventTail;     ///< written by Pcf8574_ProcessEvents() only
+    volatile uint32_t u32EventOverflows; ///< events dropped because the ring buffer was full
+    volatile uint32_t u32ScanOutstanding; ///< devices of the running IRQ scan not done yet
+    volatile boolean_t bScanBusy;       ///< IRQ scan in progress
+    volatile boolean_t bScanPending;    ///< IRQ occurred during scan, scan again when done
+    volatile uint32_t u32FlushOutstanding; ///< devices of the running group flush not done yet
+    en_result_t enFlushResult;
+    pfn_pcf8574_group_done_t pfnFlushDone;
+#if PCF8574_ENABLE_STATS
+    stc_pcf8574_stats_t stcStats;
+    volatile boolean_t bScanChanged;    ///< a device changed during the running IRQ scan
+#endif
+    uint32_t u32ScanBudget;             ///< blocking reads per IRQ scan step, the rest follows next tick, 0 = unlimited
+    stc_pcf8574_list_item_t* pstcScanNext; ///< next device of a split IRQ scan
+    stc_pcf8574_timer_t stcScanTimer;   ///< continues a split IRQ scan
+    volatile uint32_t u32ScanTick;      ///< ms tick of the IRQ served by the running scan
+    volatile uint32_t u32PendingTick;   ///< ms tick of the first IRQ during the running scan
+    volatile uint32_t u32DeadlineMisses; ///< devices of the group serviced later than their u32MaxLatencyMs
+    pfn_pcf8574_int_read_t pfnIntRead;  ///< optional INT line read function, enables cached reads
+    void* pIntHandle;                   ///< handle for pfnIntRead
+    volatile uint32_t u32IrqEpoch;      ///< incremented by every IRQ handling, invalidates the shadows of the group
+    pfn_pcf8574_irq_mask_t pfnIrqMask;  ///< optional, masks the INT interrupt while the group is polled
+    void* pMaskHandle;                  ///< handle for pfnIrqMask
+    uint32_t u32StormThreshold;         ///< IRQs per PCF8574_STORM_WINDOW_MS that switch to polling, 0 = storm detection off
+    uint32_t u32StormPollMs;            ///< poll interval while polled
+    uint32_t u32StormIrqs;              ///< IRQs in the current window
+    uint32_t u32StormWindowStart;       ///< ms tick of the current window
+    uint32_t u32StormQuietStart;        ///< ms tick of the last poll with activity
+    volatile uint32_t u32StormActivity; ///< device changes seen by the scans of the group
+    uint32_t u32StormLastActivity;      ///< u32StormActivity at the last poll
+    volatile boolean_t bStorm;          ///< TRUE = interrupt storm, the group is polled
+    uint32_t u32StormEnters;            ///< switches to polling
+    uint32_t u32StormExits;             ///< switches back to IRQ mode
+    stc_pcf8574_timer_t stcStormTimer;  ///< poll timer while polled, INT recheck after a scan otherwise
+#if PCF8574_REGISTRY_SIZE > 0
+    uint32_t u32RegCount;               ///< devices in the registry, pstcListRoot is not used
+    stc_pcf8574_list_item_t* apstcRegItems[PCF8574_REGISTRY_SIZE]; ///< list items, sorted by priority
+    stc_pcf8574_handle_t* apstcRegDevices[PCF8574_REGISTRY_SIZE]; ///< device of the list item (device of the encoder)
+    uint8_t au8RegPriority[PCF8574_REGISTRY_SIZE]; ///< priority of the list items
+#endif
+} stc_pcf8574_group_t;
+
 /**
  ** \brief PCF8574 Rotary encoder handle
  */
@@ -224,13 +616,61 @@ typedef struct stc_pcf8574_rotaryencoder
     uint8_t Btn;
     int32_t Counter;
     int32_t CounterOld;
-    uint8_t u8OldData;
+    pcf8574_port_t portOldData;
     boolean_t bButtonClicked;
     boolean_t bButton;
     boolean_t bButtonOld;
     uint32_t u32LastPressedTime;
+    en_pcf8574_quad_mode_t enQuadMode; ///< decoding resolution
+    uint8_t u8QuadState;      ///< last state of A (bit 1) and B (bit 0)
+    uint32_t u32QuadErrors;   ///< rejected transitions (A and B changed at once)
+    int32_t i32Velocity;      ///< steps per second, signed by direction
+    int32_t i32Acceleration;  ///< steps per second^2
+    uint32_t u32LastStepTime; ///< ms tick of the last step
+    uint16_t u16ScaleVelocity; ///< velocity in steps/s per additional count of one step, 0 = no speed scaling
+    uint8_t u8ScaleMax;       ///< maximum counts of one step with speed scaling, 0 = unlimited
+    stc_pcf8574_timer_t stcButtonTimer; ///< counts u32LastPressedTime while the button is held
+    stc_pcf8574_timer_t stcIdleTimer;   ///< resets velocity and acceleration without steps
 } stc_pcf8574_rotaryencoder_t;
 
+/**
+ ** \brief PCF8574 matrix keypad handle
+ **
+ ** Rows and columns are numbered from the lowest GPIO of their mask,
+ ** rows * columns must not exceed 32. Without diodes at the keys, three
+ ** keys at the corners of a rectangle show a fourth key (ghosting), new
+ ** keys of such scans are rejected.
+ */
+typedef struct stc_pcf8574_keypad
+{
+    stc_pcf8574_handle_t* pHandle;
+    pcf8574_port_t portRows;  ///< GPIOs of the rows, inputs (pulled up)
+    pcf8574_port_t portCols;  ///< GPIOs of the columns, driven low while idle
+    pfn_pcf8574_key_callback_t pfnCallback;
+    uint32_t u32Keys;         ///< pressed keys, bit = row * columns + column
+    uint32_t u32Ghosts;       ///< scans with rejected keys because of ghosting
+    uint32_t u32Scans;        ///< matrix scans
+    stc_pcf8574_timer_t stcScanTimer; ///< delays the scan after INT, rescans while keys are held
+} stc_pcf8574_keypad_t;
+
+/**
+ ** \brief Output sequencer of one GPIO, see Pcf8574_SeqStart()
+ **
+ ** The GPIO is switched by the ms tick, all GPIO changes of one device
+ ** due in the same tick are written in one transfer.
+ */
+typedef struct stc_pcf8574_seq
+{
+    stc_pcf8574_handle_t* pHandle;
+    uint8_t u8Pin;
+    boolean_t bActiveLow;     ///< TRUE = GPIO low while on (LED to VCC)
+    boolean_t bOn;            ///< current state of the pattern
+    uint32_t u32OnMs;         ///< on time of one period
+    uint32_t u32OffMs;        ///< off time of one period
+    uint32_t u32Remain;       ///< remaining periods, 0 = endless
+    stc_pcf8574_timer_t stcTimer;
+} stc_pcf8574_seq_t;
+
 
 /**
  *******************************************************************************
@@ -244,19 +684,74 @@ typedef struct stc_pcf8574_rotaryencoder
  *******************************************************************************
  */
 
+en_result_t Pcf8574_InitGroup(stc_pcf8574_group_t* pstcGroup);
+en_result_t Pcf8574_DeinitGroup(stc_pcf8574_group_t* pstcGroup);
 en_result_t Pcf8574_Init(stc_pcf8574_handle_t* pstcHandle, stc_pcf8574_list_item_t* pstcListItemOut);
+en_result_t Pcf8574_InitInGroup(stc_pcf8574_group_t* pstcGroup, stc_pcf8574_handle_t* pstcHandle, stc_pcf8574_list_item_t* pstcListItemOut);
 en_result_t Pcf8574_Deinit(stc_pcf8574_handle_t* pstcHandle, stc_pcf8574_list_item_t* pstcListItemOut);
+en_result_t Pcf8574_DeinitInGroup(stc_pcf8574_group_t* pstcGroup, stc_pcf8574_handle_t* pstcHandle, stc_pcf8574_list_item_t* pstcListItemOut);
 en_result_t Pcf8574_InitCallback(stc_pcf8574_handle_t* pstcHandle, uint8_t u8Bit, en_pcf8574_irq_trigger_t enType, pfn_pcf8574_callback_t pfnCallback);
 en_result_t Pcf8574_DeinitCallback(stc_pcf8574_handle_t* pstcHandle, uint8_t u8Bit);
-uint8_t Pcf8574_Read(stc_pcf8574_handle_t* pstcHandle);
-void Pcf8574_Write(stc_pcf8574_handle_t* pstcHandle, uint8_t u8Value);
+en_result_t Pcf8574_InitPortCallback(stc_pcf8574_handle_t* pstcHandle, pfn_pcf8574_port_callback_t pfnCallback);
+en_result_t Pcf8574_InitDebounce(stc_pcf8574_handle_t* pstcHandle, boolean_t bEnable);
+en_result_t Pcf8574_InitPoll(stc_pcf8574_group_t* pstcGroup, stc_pcf8574_handle_t* pstcHandle, uint32_t u32MinMs, uint32_t u32MaxMs, stc_pcf8574_poll_budget_t* pstcBudget);
+en_result_t Pcf8574_DeinitPoll(stc_pcf8574_handle_t* pstcHandle);
+en_result_t Pcf8574_InitPollBudget(stc_pcf8574_poll_budget_t* pstcBudget, uint32_t u32BytesPerSecond, uint32_t u32Burst);
+en_result_t Pcf8574_SetPriority(stc_pcf8574_list_item_t* pstcListItem, uint8_t u8Priority, uint32_t u32MaxLatencyMs);
+en_result_t Pcf8574_InitScanBudget(stc_pcf8574_group_t* pstcGroup, uint32_t u32MaxReads);
+pcf8574_port_t Pcf8574_Read(stc_pcf8574_handle_t* pstcHandle);
+pcf8574_port_t Pcf8574_ReadBurst(stc_pcf8574_handle_t* pstcHandle, uint8_t u8Samples, en_pcf8574_filter_t enFilter);
+en_result_t Pcf8574_InitIntRead(stc_pcf8574_group_t* pstcGroup, pfn_pcf8574_int_read_t pfnIntRead, void* pIntHandle);
+en_result_t Pcf8574_InitStorm(stc_pcf8574_group_t* pstcGroup, uint32_t u32Threshold, uint32_t u32PollMs, pfn_pcf8574_irq_mask_t pfnIrqMask, void* pMaskHandle);
+boolean_t Pcf8574_GetStormStatus(stc_pcf8574_group_t* pstcGroup, uint32_t* pu32Enters, uint32_t* pu32Exits);
+en_result_t Pcf8574_InitCachedRead(stc_pcf8574_group_t* pstcGroup, stc_pcf8574_handle_t* pstcHandle, boolean_t bEnable);
+en_result_t Pcf8574_ReadAll(stc_pcf8574_group_t* pstcGroup, pcf8574_port_t* paportValues, uint32_t u32Size, stc_pcf8574_snapshot_t* pstcSnapshot);
+void Pcf8574_Write(stc_pcf8574_handle_t* pstcHandle, pcf8574_port_t portValue);
+en_result_t Pcf8574_SetPin(stc_pcf8574_handle_t* pstcHandle, uint8_t u8Bit);
+en_result_t Pcf8574_ClearPin(stc_pcf8574_handle_t* pstcHandle, uint8_t u8Bit);
+en_result_t Pcf8574_TogglePin(stc_pcf8574_handle_t* pstcHandle, uint8_t u8Bit);
+void Pcf8574_SetPins(stc_pcf8574_handle_t* pstcHandle, pcf8574_port_t portMask);
+void Pcf8574_ClearPins(stc_pcf8574_handle_t* pstcHandle, pcf8574_port_t portMask);
+void Pcf8574_TogglePins(stc_pcf8574_handle_t* pstcHandle, pcf8574_port_t portMask);
+void Pcf8574_ModifyPins(stc_pcf8574_handle_t* pstcHandle, pcf8574_port_t portClearMask, pcf8574_port_t portSetMask);
+en_result_t Pcf8574_Flush(stc_pcf8574_handle_t* pstcHandle);
+en_result_t Pcf8574_WriteStream(stc_pcf8574_handle_t* pstcHandle, const uint8_t* pu8Sequence, uint32_t u32Len);
+en_result_t Pcf8574_InitBus(stc_pcf8574_bus_t* pstcBus, void* pI2cHandle, pfn_pcf8574_i2c_submit_t pfnSubmit);
+void Pcf8574_XferComplete(stc_pcf8574_xfer_t* pstcXfer, int iResult);
+en_result_t Pcf8574_ReadAsync(stc_pcf8574_handle_t* pstcHandle, pfn_pcf8574_done_t pfnDone);
+en_result_t Pcf8574_WriteAsync(stc_pcf8574_handle_t* pstcHandle, pcf8574_port_t portValue, pfn_pcf8574_done_t pfnDone);
+en_result_t Pcf8574_FlushAsync(stc_pcf8574_handle_t* pstcHandle, pfn_pcf8574_done_t pfnDone);
+en_result_t Pcf8574_WriteStreamAsync(stc_pcf8574_handle_t* pstcHandle, const uint8_t* pu8Sequence, uint32_t u32Len, pfn_pcf8574_done_t pfnDone);
 en_result_t Pcf8574_InitRotaryEncoder(stc_pcf8574_rotaryencoder_t* pstcHandle, stc_pcf8574_list_item_t* pstcListItemOut);
+en_result_t Pcf8574_InitRotaryEncoderInGroup(stc_pcf8574_group_t* pstcGroup, stc_pcf8574_rotaryencoder_t* pstcHandle, stc_pcf8574_list_item_t* pstcListItemOut);
 void Pcf8574_HandleRotaryEncoder(stc_pcf8574_rotaryencoder_t* pstcHandle);
+en_result_t Pcf8574_InitKeypad(stc_pcf8574_group_t* pstcGroup, stc_pcf8574_keypad_t* pstcHandle, stc_pcf8574_list_item_t* pstcListItemOut);
+en_result_t Pcf8574_DeinitKeypad(stc_pcf8574_keypad_t* pstcHandle, stc_pcf8574_list_item_t* pstcListItemOut);
+en_result_t Pcf8574_SeqStart(stc_pcf8574_seq_t* pstcSeq, stc_pcf8574_handle_t* pstcHandle, uint8_t u8Pin, boolean_t bActiveLow, uint32_t u32OnMs, uint32_t u32OffMs, uint32_t u32Repeat);
+en_result_t Pcf8574_SeqPulse(stc_pcf8574_seq_t* pstcSeq, stc_pcf8574_handle_t* pstcHandle, uint8_t u8Pin, boolean_t bActiveLow, uint32_t u32Ms);
+en_result_t Pcf8574_SeqPwm(stc_pcf8574_seq_t* pstcSeq, stc_pcf8574_handle_t* pstcHandle, uint8_t u8Pin, boolean_t bActiveLow, uint32_t u32PeriodMs, uint8_t u8DutyPercent);
+en_result_t Pcf8574_SeqStop(stc_pcf8574_seq_t* pstcSeq);
 void Pcf8574_MsTickHandle(void);
 void Pcf8574_ExecuteIrqHandle(stc_pcf8574_handle_t* pHandle);
 void Pcf8574_ExtIrqHandle(void);
 void Pcf8574_LockIrq(void);
 void Pcf8574_UnlockIrq(void);
+void Pcf8574_GroupIrqHandle(stc_pcf8574_group_t* pstcGroup);
+void Pcf8574_GroupLockIrq(stc_pcf8574_group_t* pstcGroup);
+void Pcf8574_GroupUnlockIrq(stc_pcf8574_group_t* pstcGroup);
+en_result_t Pcf8574_GroupFlush(stc_pcf8574_group_t* pstcGroup, pfn_pcf8574_group_done_t pfnDone);
+en_result_t Pcf8574_InitEventQueue(stc_pcf8574_group_t* pstcGroup, stc_pcf8574_event_t* pastcBuffer, uint32_t u32Size);
+void Pcf8574_ProcessEvents(void);
+uint32_t Pcf8574_GroupProcessEvents(stc_pcf8574_group_t* pstcGroup);
+uint32_t Pcf8574_GetEventOverflows(stc_pcf8574_group_t* pstcGroup);
+uint32_t Pcf8574_GetDeadlineMisses(stc_pcf8574_group_t* pstcGroup);
+uint32_t Pcf8574_GetTicks(void);
+en_result_t Pcf8574_GetStats(stc_pcf8574_handle_t* pstcHandle, stc_pcf8574_stats_t* pstcStatsOut);
+en_result_t Pcf8574_ResetStats(stc_pcf8574_handle_t* pstcHandle);
+en_result_t Pcf8574_GroupGetStats(stc_pcf8574_group_t* pstcGroup, stc_pcf8574_stats_t* pstcStatsOut);
+en_result_t Pcf8574_GroupResetStats(stc_pcf8574_group_t* pstcGroup);
+en_result_t Pcf8574_TimerStart(stc_pcf8574_timer_t* pstcTimer, uint32_t u32Delay, pfn_pcf8574_timer_t pfnExpired, void* pHandle, void* pUser);
+void Pcf8574_TimerStop(stc_pcf8574_timer_t* pstcTimer);
 
 //@} // Pcf8574Group
 
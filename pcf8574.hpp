@@ -0,0 +1,447 @@
+/**
+ *******************************************************************************
+ ** Created by the pcf8574 contributors
+ **
+ ** Copyright © 2026 pcf8574 contributors. All rights reserved.
+ **
+ ** 1. Redistributions of source code must retain the above copyright notice,
+ **    this condition and the following disclaimer.
+ **
+ ** This software is provided by the copyright holder and contributors "AS IS"
+ ** and any warranties related to this software are DISCLAIMED.
+ ** The copyright owner or contributors be NOT LIABLE for any damages caused
+ ** by use of this software.
+
+ *******************************************************************************
+ */
+
+/**
+ *******************************************************************************
+ **\file pcf8574.hpp
+ **
+ ** Header-only C++17 front-end of the PCF8574 I2C port expander driver
+ **
+ ** Pins, directions and edge handlers are template parameters, so all masks
+ ** and the edge dispatch are resolved at compile time and handlers are
+ ** inlined. The C core (pcf8574.c) is used unchanged underneath.
+ **
+ ** History:
+ ** - 2026-10-16 1.00  First version
+ *******************************************************************************
+ */
+
+#if !defined(__PCF8574_HPP__)
+#define __PCF8574_HPP__
+
+/**
+ *******************************************************************************
+ ** \page pcf8574_cpp_example Example of the C++ front-end
+ ** \brief Following code gives some short example
+ ** @code
+ ** #include "pcf8574.hpp"
+ **
+ ** struct I2c0
+ ** {
+ **     static void* Handle(void)  //optional, pHandle of Read() / Write(), NULL without
+ **     {
+ **         return I2C0;
+ **     }
+ **     static int Read(void* pHandle, uint32_t u32Address, uint8_t* pu8Data, uint32_t u32Len)
+ **     {
+ **         return HAL_I2cRead(pHandle,u32Address,pu8Data,u32Len);  //0 on success
+ **     }
+ **     static int Write(void* pHandle, uint32_t u32Address, uint8_t* pu8Data, uint32_t u32Len)
+ **     {
+ **         return HAL_I2cWrite(pHandle,u32Address,pu8Data,u32Len); //0 on success
+ **     }
+ ** };
+ **
+ ** struct OnKey
+ ** {
+ **     void operator()(uint8_t u8Pin, bool bRising) const
+ **     {
+ **         //handle key at GPIO0, inlined into the dispatch
+ **     }
+ ** };
+ **
+ ** constexpr auto OnAlarm = [](uint8_t u8Pin, bool bRising) { };
+ **
+ ** using Board = pcf8574::Pcf8574<I2c0, (0x70>>1),
+ **                                pcf8574::IrqPin<0, pcf8574::Edge::Falling, OnKey>,
+ **                                pcf8574::IrqPin<1, pcf8574::Edge::Both, pcf8574::Call<OnAlarm>>,
+ **                                pcf8574::Pin<4>>;
+ **
+ ** void GpioCallback(void)
+ ** {
+ **     Pcf8574_ExtIrqHandle();
+ ** }
+ **
+ ** int main(void)
+ ** {
+ **     Board::Init();
+ **     Board::Clear<4>();         //stage GPIO4 low
+ **     Board::Flush();            //one write, GPIO0 and GPIO1 stay high (inputs)
+ **     //Board::Clear<0>();       //does not compile, GPIO0 is an input
+ ** }
+ ** @endcode
+ **
+ *******************************************************************************
+ */
+
+/**
+ *******************************************************************************
+ ** (Global) Include files
+ *******************************************************************************
+ */
+
+#include <type_traits>
+#include "pcf8574.h"
+
+/**
+ *******************************************************************************
+ ** Global type definitions ('typedef')
+ *******************************************************************************
+ */
+
+namespace pcf8574
+{
+
+/**
+ ** \brief Pin direction, inputs are kept high (quasi-bidirectional GPIO)
+ */
+enum class Dir : uint8_t
+{
+    Out = 0,
+    In
+};
+
+/**
+ ** \brief Edges a pin handler is called for
+ */
+enum class Edge : uint8_t
+{
+    None = 0,
+    Rising,
+    Falling,
+    Both
+};
+
+/**
+ ** \brief Handler placeholder for pins without edge handler
+ */
+struct NoHandler
+{
+};
+
+/**
+ ** \brief Handler calling a constexpr function object, e.g. a lambda: Call<OnAlarm>
+ */
+template<const auto& Fn>
+struct Call
+{
+    void operator()(uint8_t u8Pin, bool bRising) const
+    {
+        Fn(u8Pin,bRising);
+    }
+};
+
+/**
+ ** \brief Pin configuration
+ **
+ ** \tparam N GPIO number
+ **
+ ** \tparam D Direction
+ **
+ ** \tparam E Edges calling the handler
+ **
+ ** \tparam Handler Default constructible functor, called as Handler{}(uint8_t u8Pin, bool bRising)
+ */
+template<uint8_t N, Dir D = Dir::Out, Edge E = Edge::None, typename Handler = NoHandler>
+struct Pin
+{
+    static_assert(N < PCF8574_MAX_PORT_BITS, "pin exceeds PCF8574_MAX_PORT_BITS");
+    static_assert((E == Edge::None) || !std::is_same<Handler, NoHandler>::value, "edge pin requires a handler");
+
+    using handler_t = Handler;
+    static constexpr uint8_t u8Bit = N;
+    static constexpr pcf8574_port_t portMask = (pcf8574_port_t)((pcf8574_port_t)1 << N);
+    static constexpr pcf8574_port_t portInputMask = (D == Dir::In) ? portMask : 0;
+    static constexpr pcf8574_port_t portRiseMask = ((E == Edge::Rising) || (E == Edge::Both)) ? portMask : 0;
+    static constexpr pcf8574_port_t portFallMask = ((E == Edge::Falling) || (E == Edge::Both)) ? portMask : 0;
+};
+
+/**
+ ** \brief Input pin with edge handler
+ */
+template<uint8_t N, Edge E, typename Handler>
+using IrqPin = Pin<N, Dir::In, E, Handler>;
+
+/**
+ ** \brief Input pin without handler, read with Get<N>()
+ */
+template<uint8_t N>
+using InPin = Pin<N, Dir::In>;
+
+/**
+ ** \brief I2C handle of a bus type, Bus::Handle() if the bus provides it, else NULL
+ */
+template<typename Bus, typename = void>
+struct BusHandle
+{
+    static void* Get(void)
+    {
+        return NULL;
+    }
+};
+
+template<typename Bus>
+struct BusHandle<Bus, std::void_t<decltype(Bus::Handle())>>
+{
+    static void* Get(void)
+    {
+        return Bus::Handle();
+    }
+};
+
+/**
+ ** \brief Port expander with compile-time pin configuration
+ **
+ ** One type is one device: the C handle is a static member, so every access
+ ** is a direct access without handle indirection or NULL checks.
+ **
+ ** \tparam Bus Type with static int Read(...) / Write(...) of type
+ **             pfn_pcf8574_i2c_read_t / pfn_pcf8574_i2c_write_t, optional
+ **             static void* Handle() returning the I2C handle passed to them
+ **
+ ** \tparam Address 7-bit I2C address
+ **
+ ** \tparam PortBits Port width, 8 for PCF8574, 16 for PCF8575
+ **
+ ** \tparam Pins Pin configurations
+ */
+template<typename Bus, uint32_t Address, uint8_t PortBits, typename... Pins>
+class Expander
+{
+    static_assert(PortBits <= PCF8574_MAX_PORT_BITS, "PortBits exceeds PCF8574_MAX_PORT_BITS");
+
+public:
+    static constexpr pcf8574_port_t portPinMask = (pcf8574_port_t)(0 | ... | Pins::portMask);
+    static constexpr pcf8574_port_t portInputMask = (pcf8574_port_t)(0 | ... | Pins::portInputMask);
+    static constexpr pcf8574_port_t portRiseMask = (pcf8574_port_t)(0 | ... | Pins::portRiseMask);
+    static constexpr pcf8574_port_t portFallMask = (pcf8574_port_t)(0 | ... | Pins::portFallMask);
+
+    static_assert((true && ... && (Pins::u8Bit < PortBits)), "pin exceeds port width");
+    static_assert((0ULL + ... + Pins::portMask) == portPinMask, "pin configured twice");
+
+    /**
+     ** \brief Init the device in an interrupt group
+     **
+     ** The whole handle is reset, Init() after Deinit() starts from scratch.
+     **
+     ** \param pstcGroup Pointer of group, NULL for the default group
+     **
+     ** \returns Ok on success
+     */
+    static en_result_t Init(stc_pcf8574_group_t* pstcGroup = NULL)
+    {
+        PCF8574_CONFIG_INIT(stcHandle);
+        stcHandle.pI2cHandle = BusHandle<Bus>::Get();
+        stcHandle.u32Address = Address;
+        stcHandle.pfnRead = &Bus::Read;
+        stcHandle.pfnWrite = &Bus::Write;
+        stcHandle.u8PortBits = PortBits;
+        if constexpr ((portRiseMask | portFallMask) != 0)
+        {
+            stcHandle.pfnPortCallback = &PortCallback;
+            return Pcf8574_InitInGroup(pstcGroup,&stcHandle,&stcListItem);
+        }
+        return Pcf8574_InitInGroup(pstcGroup,&stcHandle,NULL);
+    }
+
+    /**
+     ** \brief Deinit the device
+     **
+     ** \param pstcGroup Pointer of group used at Init()
+     **
+     ** \returns Ok on success
+     */
+    static en_result_t Deinit(stc_pcf8574_group_t* pstcGroup = NULL)
+    {
+        return Pcf8574_DeinitInGroup(pstcGroup,&stcHandle,((portRiseMask | portFallMask) != 0) ? &stcListItem : NULL);
+    }
+
+    /**
+     ** \brief C handle for use with the C API
+     */
+    static stc_pcf8574_handle_t* Handle(void)
+    {
+        return &stcHandle;
+    }
+
+    /**
+     ** \brief Stage GPIO N high, written by Flush()
+     */
+    template<uint8_t N>
+    static void Set(void)
+    {
+        PCF8574_ENTER_CRITICAL();
+        stcHandle.portStagedValues |= OutputBit<N>();
+        PCF8574_EXIT_CRITICAL();
+    }
+
+    /**
+     ** \brief Stage GPIO N low, written by Flush()
+     */
+    template<uint8_t N>
+    static void Clear(void)
+    {
+        PCF8574_ENTER_CRITICAL();
+        stcHandle.portStagedValues &= (pcf8574_port_t)~OutputBit<N>();
+        PCF8574_EXIT_CRITICAL();
+    }
+
+    /**
+     ** \brief Stage toggle of GPIO N, written by Flush()
+     */
+    template<uint8_t N>
+    static void Toggle(void)
+    {
+        PCF8574_ENTER_CRITICAL();
+        stcHandle.portStagedValues ^= OutputBit<N>();
+        PCF8574_EXIT_CRITICAL();
+    }
+
+    /**
+     ** \brief Stage GPIO N to a level, written by Flush()
+     */
+    template<uint8_t N>
+    static void Put(bool bHigh)
+    {
+        if (bHigh)
+        {
+            Set<N>();
+        } else
+        {
+            Clear<N>();
+        }
+    }
+
+    /**
+     ** \brief Stage several GPIOs high with one mask built at compile time
+     */
+    template<uint8_t... N>
+    static void SetPins(void)
+    {
+        PCF8574_ENTER_CRITICAL();
+        stcHandle.portStagedValues |= (pcf8574_port_t)(0 | ... | OutputBit<N>());
+        PCF8574_EXIT_CRITICAL();
+    }
+
+    /**
+     ** \brief Stage several GPIOs low with one mask built at compile time
+     */
+    template<uint8_t... N>
+    static void ClearPins(void)
+    {
+        PCF8574_ENTER_CRITICAL();
+        stcHandle.portStagedValues &= (pcf8574_port_t)~(pcf8574_port_t)(0 | ... | OutputBit<N>());
+        PCF8574_EXIT_CRITICAL();
+    }
+
+    /**
+     ** \brief Write all staged changes in one transfer, skipped if nothing changed
+     */
+    static en_result_t Flush(void)
+    {
+        return Pcf8574_Flush(&stcHandle);
+    }
+
+    /**
+     ** \brief Write the port, input GPIOs are kept high
+     */
+    static void Write(pcf8574_port_t portValue)
+    {
+        Pcf8574_Write(&stcHandle,(pcf8574_port_t)(portValue | portInputMask));
+    }
+
+    /**
+     ** \brief Read the port from the device
+     */
+    static pcf8574_port_t Read(void)
+    {
+        return Pcf8574_Read(&stcHandle);
+    }
+
+    /**
+     ** \brief Level of GPIO N of the last read, without transfer
+     */
+    template<uint8_t N>
+    static bool Get(void)
+    {
+        static_assert(N < PortBits, "pin exceeds port width");
+        return (stcHandle.portCurrentValues & ((pcf8574_port_t)1 << N)) != 0;
+    }
+
+private:
+    template<uint8_t N>
+    static constexpr pcf8574_port_t OutputBit(void)
+    {
+        static_assert(N < PortBits, "pin exceeds port width");
+        static_assert((portInputMask & ((pcf8574_port_t)1 << N)) == 0, "pin is configured as input");
+        return (pcf8574_port_t)((pcf8574_port_t)1 << N);
+    }
+
+    template<typename P>
+    static void DispatchPin(pcf8574_port_t portRise, pcf8574_port_t portFall)
+    {
+        if constexpr (P::portRiseMask != 0)
+        {
+            if ((portRise & P::portRiseMask) != 0)
+            {
+                typename P::handler_t{}(P::u8Bit,true);
+            }
+        }
+        if constexpr (P::portFallMask != 0)
+        {
+            if ((portFall & P::portFallMask) != 0)
+            {
+                typename P::handler_t{}(P::u8Bit,false);
+            }
+        }
+    }
+
+    static void PortCallback(void* pHandle, pcf8574_port_t portRise, pcf8574_port_t portFall)
+    {
+        (void)pHandle;
+        if (((portRise & portRiseMask) | (portFall & portFallMask)) == 0)
+        {
+            return;
+        }
+        (DispatchPin<Pins>(portRise,portFall), ...);
+    }
+
+    static inline stc_pcf8574_handle_t stcHandle = {};
+    static inline stc_pcf8574_list_item_t stcListItem = {};
+};
+
+/**
+ ** \brief PCF8574, 8 GPIOs
+ */
+template<typename Bus, uint32_t Address, typename... Pins>
+using Pcf8574 = Expander<Bus, Address, 8, Pins...>;
+
+/**
+ ** \brief PCF8575, 16 GPIOs
+ */
+template<typename Bus, uint32_t Address, typename... Pins>
+using Pcf8575 = Expander<Bus, Address, 16, Pins...>;
+
+} // namespace pcf8574
+
+#endif /* __PCF8574_HPP__ */
+
+/**
+ *******************************************************************************
+ ** EOF (not truncated)
+ *******************************************************************************
+ */
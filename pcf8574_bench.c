@@ -0,0 +1,575 @@
+/**
+ *******************************************************************************
+ ** Created by the pcf8574 contributors
+ **
+ ** Copyright © 2026 pcf8574 contributors. All rights reserved.
+ **
+ ** 1. Redistributions of source code must retain the above copyright notice,
+ **    this condition and the following disclaimer.
+ **
+ ** This software is provided by the copyright holder and contributors "AS IS"
+ ** and any warranties related to this software are DISCLAIMED.
+ ** The copyright owner or contributors be NOT LIABLE for any damages caused
+ ** by use of this software.
+
+ *******************************************************************************
+ */
+
+/**
+ *******************************************************************************
+ **\file pcf8574_bench.c
+ **
+ ** Host benchmark of the PCF8574 driver against the simulated bus
+ **
+ ** Build and run on the host:
+ ** @code
+ ** gcc -std=c99 -O2 pcf8574_bench.c pcf8574.c pcf8574_sim.c -o pcf8574_bench
+ ** ./pcf8574_bench > results.csv
+ ** @endcode
+ **
+ ** Output is CSV, one row per configuration, the first column names the
+ ** benchmark ("irq", "multibus" or "write"), lines starting with # are headers.
+ ** Latencies and bus figures are simulated bus time, cpu_ns columns are
+ ** host CPU time.
+ **
+ ** History:
+ ** - 2026-10-16 1.00  First version
+ *******************************************************************************
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+/**
+ *******************************************************************************
+ ** Include files
+ *******************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "base_types.h"
+#include "pcf8574.h"
+#include "pcf8574_sim.h"
+
+/**
+ *******************************************************************************
+ ** Local pre-processor symbols/macros ('#define')
+ *******************************************************************************
+ */
+
+#define BENCH_MAX_DEVICES   64
+#define BENCH_EVENTS        256
+#define BENCH_STREAM_LEN    64
+#define BENCH_WRITES        1000
+#define BENCH_MAX_BUSES     4
+#define BENCH_SCANS         16
+
+/**
+ *******************************************************************************
+ ** Local variable definitions ('static')
+ *******************************************************************************
+ */
+
+static const uint32_t au32DeviceCounts[] = { 1, 2, 4, 8, 16, 32, 64 };
+static const uint32_t au32BitRates[] = { PCF8574_SIM_100KHZ, PCF8574_SIM_400KHZ, PCF8574_SIM_1000KHZ };
+static const uint32_t au32EventRates[] = { 100, 1000, 10000 };
+static const uint32_t au32BusCounts[] = { 1, 2, 4 };
+
+static stc_pcf8574_sim_bus_t stcBus;
+static stc_pcf8574_sim_device_t astcSimDevices[BENCH_MAX_DEVICES];
+static stc_pcf8574_handle_t astcHandles[BENCH_MAX_DEVICES];
+static stc_pcf8574_list_item_t astcItems[BENCH_MAX_DEVICES];
+static stc_pcf8574_sim_step_t astcSteps[BENCH_MAX_DEVICES][BENCH_EVENTS];
+static uint32_t au32StepCount[BENCH_MAX_DEVICES];
+static uint32_t au32Callbacks[BENCH_MAX_DEVICES];
+static uint32_t au32NextStep[BENCH_MAX_DEVICES];
+static uint32_t au32Matched[BENCH_MAX_DEVICES];
+static uint64_t au64Latency[BENCH_EVENTS];
+static uint32_t u32LatencyCount;
+static uint64_t u64IrqCpuNs;
+static uint32_t u32IrqCalls;
+static uint32_t u32Random = 1;
+static stc_pcf8574_sim_bus_t astcSimBuses[BENCH_MAX_BUSES];
+static stc_pcf8574_bus_t astcBuses[BENCH_MAX_BUSES];
+static stc_pcf8574_xfer_t* apstcBusXfer[BENCH_MAX_BUSES];
+static uint64_t au64BusSubmitNs[BENCH_MAX_BUSES];
+static uint64_t u64MultiBusNowNs;
+
+/**
+ *******************************************************************************
+ ** Function implementation - local ('static')
+ *******************************************************************************
+ */
+
+/**
+ ** \brief Host CPU time stamp
+ **
+ ** \returns time in ns
+ */
+static uint64_t CpuNs(void)
+{
+    struct timespec stcTime;
+    clock_gettime(CLOCK_MONOTONIC,&stcTime);
+    return (uint64_t)stcTime.tv_sec * 1000000000ULL + (uint64_t)stcTime.tv_nsec;
+}
+
+/**
+ ** \brief Deterministic pseudo random number
+ **
+ ** \returns 31-bit random value
+ */
+static uint32_t Random(void)
+{
+    u32Random = u32Random * 1103515245UL + 12345UL;
+    return (u32Random >> 1) & 0x7FFFFFFFUL;
+}
+
+/**
+ ** \brief Sort compare of latencies
+ */
+static int CompareLatency(const void* pA, const void* pB)
+{
+    uint64_t u64A = *(const uint64_t*)pA;
+    uint64_t u64B = *(const uint64_t*)pB;
+    return (u64A > u64B) - (u64A < u64B);
+}
+
+/**
+ ** \brief Shared INT line of the simulated bus asserted
+ */
+static void BenchIntCallback(stc_pcf8574_sim_bus_t* pstcBus)
+{
+    uint64_t u64Start = CpuNs();
+    (void)pstcBus;
+    Pcf8574_ExtIrqHandle();
+    u64IrqCpuNs += CpuNs() - u64Start;
+    u32IrqCalls++;
+}
+
+/**
+ ** \brief INT line of the simulated bus for the recheck after a scan
+ **
+ ** \param pHandle Pointer of the simulated bus
+ **
+ ** \returns TRUE while INT is asserted
+ */
+static boolean_t BenchIntRead(void* pHandle)
+{
+    return Pcf8574Sim_GetInt((stc_pcf8574_sim_bus_t*)pHandle);
+}
+
+/**
+ ** \brief GPIO0 changed at a device, records the latency to the scripted step
+ **
+ ** The callback is matched to the latest step at or before now that set the
+ ** sampled level. Steps skipped by the match were merged with a later step
+ ** or lost, they are counted by BenchIrq() and have no latency.
+ */
+static void BenchPinCallback(void* pHandle, uint8_t u8Pin)
+{
+    uint32_t u32Device = (uint32_t)((stc_pcf8574_handle_t*)pHandle - &astcHandles[0]);
+    pcf8574_port_t portLevel = (pcf8574_port_t)(((stc_pcf8574_handle_t*)pHandle)->portCurrentValues & 0x01);
+    uint64_t u64Now = Pcf8574Sim_GetTimeNs(&stcBus);
+    uint32_t u32Step = au32NextStep[u32Device];
+    (void)u8Pin;
+    au32Callbacks[u32Device]++;
+    while((u32Step < au32StepCount[u32Device]) && (astcSteps[u32Device][u32Step].u64TimeNs <= u64Now))
+    {
+        u32Step++;
+    }
+    while((u32Step > au32NextStep[u32Device]) && (astcSteps[u32Device][u32Step - 1].portDriveValue != portLevel))
+    {
+        u32Step--;
+    }
+    if (u32Step == au32NextStep[u32Device])
+    {
+        return; //no new step with this level
+    }
+    au32NextStep[u32Device] = u32Step;
+    au32Matched[u32Device]++;
+    if (u32LatencyCount < BENCH_EVENTS)
+    {
+        au64Latency[u32LatencyCount++] = u64Now - astcSteps[u32Device][u32Step - 1].u64TimeNs;
+    }
+}
+
+/**
+ ** \brief Set up the simulated bus with devices and the driver handles
+ **
+ ** \param u32Devices Number of devices
+ **
+ ** \param u32BitRate SCL frequency in Hz
+ **
+ ** \param bVectored TRUE = devices use the vectored transport (combined scan transfers)
+ */
+static void SetupDevices(uint32_t u32Devices, uint32_t u32BitRate, boolean_t bVectored)
+{
+    uint32_t i;
+    Pcf8574Sim_InitBus(&stcBus,u32BitRate,BenchIntCallback);
+    for(i = 0;i < u32Devices;i++)
+    {
+        Pcf8574Sim_InitDevice(&stcBus,&astcSimDevices[i],0x20 + i,8);
+        PCF8574_CONFIG_INIT(astcHandles[i]);
+        astcHandles[i].pI2cHandle = &stcBus;
+        astcHandles[i].u32Address = 0x20 + i;
+        astcHandles[i].pfnRead = Pcf8574Sim_Read;
+        astcHandles[i].pfnWrite = Pcf8574Sim_Write;
+        astcHandles[i].pfnTransfer = bVectored ? Pcf8574Sim_Transfer : NULL;
+        Pcf8574_Init(&astcHandles[i],&astcItems[i]);
+        Pcf8574_InitCallback(&astcHandles[i],0,Pcf8574RisingFallingEdge,BenchPinCallback);
+        au32StepCount[i] = 0;
+        au32Callbacks[i] = 0;
+        au32NextStep[i] = 0;
+        au32Matched[i] = 0;
+    }
+    Pcf8574_InitIntRead(NULL,BenchIntRead,&stcBus);
+}
+
+/**
+ ** \brief Remove the driver handles of the last setup
+ **
+ ** \param u32Devices Number of devices
+ */
+static void TeardownDevices(uint32_t u32Devices)
+{
+    uint32_t i;
+    Pcf8574_InitIntRead(NULL,NULL,NULL);
+    for(i = 0;i < u32Devices;i++)
+    {
+        Pcf8574_Deinit(&astcHandles[i],&astcItems[i]);
+    }
+}
+
+/**
+ ** \brief INT-to-callback latency, bus transactions per event and CPU time
+ **
+ ** Events toggle GPIO0 of a random device at a fixed rate. If a scan takes
+ ** longer than the event period, toggles of a device are merged or lost,
+ ** the lost_events column counts scripted steps without a callback.
+ **
+ ** \param u32Devices Number of devices
+ **
+ ** \param u32BitRate SCL frequency in Hz
+ **
+ ** \param u32EventRate Events per second
+ **
+ ** \param bVectored TRUE = scan with vectored transfers
+ */
+static void BenchIrq(uint32_t u32Devices, uint32_t u32BitRate, uint32_t u32EventRate, boolean_t bVectored)
+{
+    uint64_t u64Period = 1000000000ULL / u32EventRate;
+    uint64_t u64Start;
+    uint64_t u64End;
+    uint64_t u64TickCpuNs = 0;
+    uint32_t u32Ticks = 0;
+    uint32_t u32Transactions;
+    uint32_t u32Bytes;
+    uint32_t u32Device;
+    uint32_t u32CallbackCount = 0;
+    uint32_t u32MatchedCount = 0;
+    uint32_t i;
+
+    SetupDevices(u32Devices,u32BitRate,bVectored);
+    for(i = 0;i < BENCH_EVENTS;i++)
+    {
+        u32Device = Random() % u32Devices;
+        astcSteps[u32Device][au32StepCount[u32Device]].u64TimeNs = stcBus.u64TimeNs + (uint64_t)(i + 1) * u64Period;
+        astcSteps[u32Device][au32StepCount[u32Device]].portDriveMask = 0x01;
+        astcSteps[u32Device][au32StepCount[u32Device]].portDriveValue = (pcf8574_port_t)(au32StepCount[u32Device] & 1);
+        au32StepCount[u32Device]++;
+    }
+    for(i = 0;i < u32Devices;i++)
+    {
+        Pcf8574Sim_SetWaveform(&astcSimDevices[i],astcSteps[i],au32StepCount[i]);
+    }
+    u32LatencyCount = 0;
+    u64IrqCpuNs = 0;
+    u32IrqCalls = 0;
+    u32Transactions = stcBus.u32Transactions;
+    u32Bytes = stcBus.u32Bytes;
+    u64End = stcBus.u64TimeNs + (uint64_t)(BENCH_EVENTS + 2) * u64Period;
+
+    while(stcBus.u64TimeNs < u64End)
+    {
+        Pcf8574Sim_Advance(&stcBus,1000000);
+        u64Start = CpuNs();
+        Pcf8574_MsTickHandle();
+        u64TickCpuNs += CpuNs() - u64Start;
+        u32Ticks++;
+    }
+    for(i = 0;i < u32Devices;i++)
+    {
+        u32CallbackCount += au32Callbacks[i];
+        u32MatchedCount += au32Matched[i];
+    }
+    qsort(au64Latency,u32LatencyCount,sizeof(uint64_t),CompareLatency);
+
+    printf("irq,%u,%u,%u,%u,%u,%u,%u",
+           (unsigned)bVectored,(unsigned)u32Devices,(unsigned)u32BitRate,(unsigned)u32EventRate,(unsigned)BENCH_EVENTS,(unsigned)u32CallbackCount,
+           (unsigned)(BENCH_EVENTS - u32MatchedCount));
+    if (u32LatencyCount > 0)
+    {
+        printf(",%.1f,%.1f,%.1f,%.1f",
+               au64Latency[0] / 1000.0,
+               au64Latency[u32LatencyCount / 2] / 1000.0,
+               au64Latency[(u32LatencyCount * 99) / 100] / 1000.0,
+               au64Latency[u32LatencyCount - 1] / 1000.0);
+    } else
+    {
+        printf(",,,,");
+    }
+    printf(",%.2f,%.2f,%.0f,%.0f,%.3f\n",
+           (double)(stcBus.u32Transactions - u32Transactions) / BENCH_EVENTS,
+           (double)(stcBus.u32Bytes - u32Bytes) / BENCH_EVENTS,
+           (u32IrqCalls > 0) ? (double)u64IrqCpuNs / u32IrqCalls : 0.0,
+           (u32Ticks > 0) ? (double)u64TickCpuNs / u32Ticks : 0.0,
+           (double)stcBus.u64BusyNs / (double)stcBus.u64TimeNs);
+    TeardownDevices(u32Devices);
+}
+
+/**
+ ** \brief Async submit of the simulated buses, the transfer is executed by RunBuses()
+ **
+ ** \param pHandle Pointer of the simulated bus
+ **
+ ** \param pstcXfer Transfer to execute
+ **
+ ** \returns 0
+ */
+static int BenchSubmit(void* pHandle, stc_pcf8574_xfer_t* pstcXfer)
+{
+    uint32_t u32Bus = (uint32_t)((stc_pcf8574_sim_bus_t*)pHandle - &astcSimBuses[0]);
+    apstcBusXfer[u32Bus] = pstcXfer;
+    au64BusSubmitNs[u32Bus] = u64MultiBusNowNs;
+    return 0;
+}
+
+/**
+ ** \brief Execute the submitted transfers of all buses in time order
+ **
+ ** Every bus works in parallel on its own bus time, a transfer starts when
+ ** it is submitted or when the previous transfer of its bus is done.
+ **
+ ** \param u32Buses Number of buses
+ */
+static void RunBuses(uint32_t u32Buses)
+{
+    stc_pcf8574_xfer_t* pstcXfer;
+    uint64_t u64Start;
+    uint32_t u32Next;
+    uint32_t i;
+    int iResult;
+    while(1)
+    {
+        u32Next = u32Buses;
+        for(i = 0;i < u32Buses;i++)
+        {
+            if (apstcBusXfer[i] == NULL)
+            {
+                continue;
+            }
+            u64Start = MAX(astcSimBuses[i].u64TimeNs,au64BusSubmitNs[i]);
+            if ((u32Next == u32Buses) || (u64Start < MAX(astcSimBuses[u32Next].u64TimeNs,au64BusSubmitNs[u32Next])))
+            {
+                u32Next = i;
+            }
+        }
+        if (u32Next == u32Buses)
+        {
+            break;
+        }
+        pstcXfer = apstcBusXfer[u32Next];
+        apstcBusXfer[u32Next] = NULL;
+        if (au64BusSubmitNs[u32Next] > astcSimBuses[u32Next].u64TimeNs)
+        {
+            Pcf8574Sim_Advance(&astcSimBuses[u32Next],au64BusSubmitNs[u32Next] - astcSimBuses[u32Next].u64TimeNs);
+        }
+        if (pstcXfer->enDir == Pcf8574XferRead)
+        {
+            iResult = Pcf8574Sim_Read(&astcSimBuses[u32Next],pstcXfer->u32Address,pstcXfer->pu8Data,pstcXfer->u32Len);
+        } else
+        {
+            iResult = Pcf8574Sim_Write(&astcSimBuses[u32Next],pstcXfer->u32Address,pstcXfer->pu8Data,pstcXfer->u32Len);
+        }
+        u64MultiBusNowNs = astcSimBuses[u32Next].u64TimeNs;
+        Pcf8574_XferComplete(pstcXfer,iResult);
+    }
+}
+
+/**
+ ** \brief IRQ scan time with the devices spread over several async buses
+ **
+ ** The devices are assigned to the buses round robin. Scans of async
+ ** devices run in parallel on all buses, the scan time should be close
+ ** to the bus time of the busiest bus instead of the sum of all buses.
+ **
+ ** \param u32Buses Number of buses
+ **
+ ** \param u32Devices Number of devices
+ **
+ ** \param u32BitRate SCL frequency in Hz
+ */
+static void BenchMultiBus(uint32_t u32Buses, uint32_t u32Devices, uint32_t u32BitRate)
+{
+    uint64_t au64BusyStart[BENCH_MAX_BUSES];
+    uint64_t u64ScanStart;
+    uint64_t u64ScanNs = 0;
+    uint64_t u64BusiestNs = 0;
+    uint64_t u64AllNs = 0;
+    uint64_t u64BusyNs;
+    uint32_t u32Bus;
+    uint32_t i;
+
+    for(i = 0;i < u32Buses;i++)
+    {
+        Pcf8574Sim_InitBus(&astcSimBuses[i],u32BitRate,NULL);
+        Pcf8574_InitBus(&astcBuses[i],&astcSimBuses[i],BenchSubmit);
+        apstcBusXfer[i] = NULL;
+    }
+    for(i = 0;i < u32Devices;i++)
+    {
+        u32Bus = i % u32Buses;
+        Pcf8574Sim_InitDevice(&astcSimBuses[u32Bus],&astcSimDevices[i],0x20 + (i / u32Buses),8);
+        PCF8574_CONFIG_INIT(astcHandles[i]);
+        astcHandles[i].pI2cHandle = &astcSimBuses[u32Bus];
+        astcHandles[i].u32Address = 0x20 + (i / u32Buses);
+        astcHandles[i].pfnRead = Pcf8574Sim_Read;
+        astcHandles[i].pfnWrite = Pcf8574Sim_Write;
+        astcHandles[i].pstcBus = &astcBuses[u32Bus];
+        Pcf8574_Init(&astcHandles[i],&astcItems[i]);
+    }
+
+    u64MultiBusNowNs = 0;
+    for(i = 0;i < u32Buses;i++)
+    {
+        u64MultiBusNowNs = MAX(u64MultiBusNowNs,astcSimBuses[i].u64TimeNs);
+    }
+    for(i = 0;i < u32Buses;i++)
+    {
+        Pcf8574Sim_Advance(&astcSimBuses[i],u64MultiBusNowNs - astcSimBuses[i].u64TimeNs);
+        au64BusyStart[i] = astcSimBuses[i].u64BusyNs;
+    }
+    for(i = 0;i < BENCH_SCANS;i++)
+    {
+        u64ScanStart = u64MultiBusNowNs;
+        Pcf8574_ExtIrqHandle();
+        RunBuses(u32Buses);
+        u64ScanNs += u64MultiBusNowNs - u64ScanStart;
+    }
+    for(i = 0;i < u32Buses;i++)
+    {
+        u64BusyNs = astcSimBuses[i].u64BusyNs - au64BusyStart[i];
+        u64BusiestNs = MAX(u64BusiestNs,u64BusyNs);
+        u64AllNs += u64BusyNs;
+    }
+
+    printf("multibus,%u,%u,%u,%.1f,%.1f,%.1f,%.2f\n",
+           (unsigned)u32Buses,(unsigned)u32Devices,(unsigned)u32BitRate,
+           u64ScanNs / 1000.0 / BENCH_SCANS,
+           u64BusiestNs / 1000.0 / BENCH_SCANS,
+           u64AllNs / 1000.0 / BENCH_SCANS,
+           (u64ScanNs > 0) ? (double)u64AllNs / (double)u64ScanNs : 0.0);
+    TeardownDevices(u32Devices);
+}
+
+/**
+ ** \brief Throughput of Pcf8574_Write and Pcf8574_WriteStream
+ **
+ ** \param u32BitRate SCL frequency in Hz
+ */
+static void BenchWrite(uint32_t u32BitRate)
+{
+    uint8_t au8Sequence[BENCH_STREAM_LEN];
+    uint64_t u64BusStart;
+    uint64_t u64CpuStart;
+    double f64WriteRate;
+    double f64WriteCpu;
+    double f64StreamRate;
+    uint32_t i;
+
+    SetupDevices(1,u32BitRate,FALSE);
+    for(i = 0;i < BENCH_STREAM_LEN;i++)
+    {
+        au8Sequence[i] = (uint8_t)i;
+    }
+
+    u64BusStart = stcBus.u64TimeNs;
+    u64CpuStart = CpuNs();
+    for(i = 0;i < BENCH_WRITES;i++)
+    {
+        Pcf8574_Write(&astcHandles[0],(pcf8574_port_t)i);
+    }
+    f64WriteCpu = (double)(CpuNs() - u64CpuStart) / BENCH_WRITES;
+    f64WriteRate = BENCH_WRITES * 1e9 / (double)(stcBus.u64TimeNs - u64BusStart);
+
+    u64BusStart = stcBus.u64TimeNs;
+    for(i = 0;i < (BENCH_WRITES / BENCH_STREAM_LEN);i++)
+    {
+        Pcf8574_WriteStream(&astcHandles[0],au8Sequence,BENCH_STREAM_LEN);
+    }
+    f64StreamRate = (i * BENCH_STREAM_LEN) * 1e9 / (double)(stcBus.u64TimeNs - u64BusStart);
+
+    printf("write,%u,%.0f,%.0f,%.0f\n",(unsigned)u32BitRate,f64WriteRate,f64StreamRate,f64WriteCpu);
+    TeardownDevices(1);
+}
+
+/**
+ *******************************************************************************
+ ** Function implementation - global ('extern')
+ *******************************************************************************
+ */
+
+int main(void)
+{
+    uint32_t u32Devices;
+    uint32_t u32BitRate;
+    uint32_t u32EventRate;
+    uint32_t u32Vectored;
+    uint32_t u32Buses;
+
+    printf("#irq,vectored,devices,bitrate_hz,event_rate_hz,events,callbacks,lost_events,lat_min_us,lat_p50_us,lat_p99_us,lat_max_us,"
+           "transactions_per_event,bytes_per_event,irq_cpu_ns,tick_cpu_ns,bus_utilization\n");
+    for(u32Vectored = 0;u32Vectored < 2;u32Vectored++)
+    {
+        for(u32Devices = 0;u32Devices < DIM(au32DeviceCounts);u32Devices++)
+        {
+            for(u32BitRate = 0;u32BitRate < DIM(au32BitRates);u32BitRate++)
+            {
+                for(u32EventRate = 0;u32EventRate < DIM(au32EventRates);u32EventRate++)
+                {
+                    BenchIrq(au32DeviceCounts[u32Devices],au32BitRates[u32BitRate],au32EventRates[u32EventRate],(boolean_t)u32Vectored);
+                }
+            }
+        }
+    }
+
+    printf("#multibus,buses,devices,bitrate_hz,scan_us,busiest_bus_us,all_buses_us,speedup\n");
+    for(u32Buses = 0;u32Buses < DIM(au32BusCounts);u32Buses++)
+    {
+        for(u32Devices = 0;u32Devices < DIM(au32DeviceCounts);u32Devices++)
+        {
+            if (au32DeviceCounts[u32Devices] < au32BusCounts[u32Buses])
+            {
+                continue;
+            }
+            for(u32BitRate = 0;u32BitRate < DIM(au32BitRates);u32BitRate++)
+            {
+                BenchMultiBus(au32BusCounts[u32Buses],au32DeviceCounts[u32Devices],au32BitRates[u32BitRate]);
+            }
+        }
+    }
+
+    printf("#write,bitrate_hz,writes_per_s,stream_states_per_s,write_cpu_ns\n");
+    for(u32BitRate = 0;u32BitRate < DIM(au32BitRates);u32BitRate++)
+    {
+        BenchWrite(au32BitRates[u32BitRate]);
+    }
+    return 0;
+}
+
+/**
+ *******************************************************************************
+ ** EOF (not truncated)
+ *******************************************************************************
+ */
@@ -0,0 +1,615 @@
+/**
+ *******************************************************************************
+ ** Created by the pcf8574 contributors
+ **
+ ** Copyright © 2026 pcf8574 contributors. All rights reserved.
+ **
+ ** 1. Redistributions of source code must retain the above copyright notice,
+ **    this condition and the following disclaimer.
+ **
+ ** This software is provided by the copyright holder and contributors "AS IS"
+ ** and any warranties related to this software are DISCLAIMED.
+ ** The copyright owner or contributors be NOT LIABLE for any damages caused
+ ** by use of this software.
+
+ *******************************************************************************
+ */
+
+/**
+ *******************************************************************************
+ **\file pcf8574_hd44780.c
+ **
+ ** HD44780 character LCD on a PCF8574 backpack
+ ** A detailed description is available at
+ ** @link Pcf8574Hd44780Group file description @endlink
+ **
+ ** History:
+ ** - 2026-10-16 1.00  First version
+ *******************************************************************************
+ */
+
+#define __PCF8574_HD44780_C__
+
+/**
+ *******************************************************************************
+ ** Include files
+ *******************************************************************************
+ */
+
+
+#include "base_types.h"
+#include "pcf8574_hd44780.h"
+
+/**
+ *******************************************************************************
+ ** Local pre-processor symbols/macros ('#define')
+ *******************************************************************************
+ */
+
+/** HD44780 commands */
+#define HD44780_CMD_CLEAR          0x01
+#define HD44780_CMD_ENTRY_MODE     0x06    ///< increment, no shift
+#define HD44780_CMD_DISPLAY_ON     0x0C    ///< display on, cursor off, blink off
+#define HD44780_CMD_FUNCTION_1LINE 0x20    ///< 4-bit, 1 line, 5x8 dots
+#define HD44780_CMD_FUNCTION_2LINE 0x28    ///< 4-bit, 2 lines, 5x8 dots
+#define HD44780_CMD_SET_DDRAM      0x80
+
+#if PCF8574_HD44780_MAX_ROWS > 8
+#error "PCF8574_HD44780_MAX_ROWS is limited to 8, rows are tracked in 8-bit masks"
+#endif
+
+/**
+ *******************************************************************************
+ ** Local variable definitions ('static')
+ *******************************************************************************
+ */
+
+static stc_pcf8574_hd44780_t* pstcHd44780Root = NULL;
+
+/**
+ *******************************************************************************
+ ** Function implementation - global ('extern') and local ('static')
+ *******************************************************************************
+ */
+
+/**
+ ** \brief DDRAM address of the first cell of a row
+ **
+ ** \param pstcLcd Pointer of LCD
+ **
+ ** \param u8Row Row
+ **
+ ** \returns DDRAM address
+ */
+static uint8_t RowAddress(stc_pcf8574_hd44780_t* pstcLcd, uint8_t u8Row)
+{
+    return (uint8_t)(((u8Row & 1) ? 0x40 : 0x00) + ((u8Row & 2) ? pstcLcd->u8Cols : 0));
+}
+
+/**
+ ** \brief Cell differs from the display
+ **
+ ** \param pstcLcd Pointer of LCD
+ **
+ ** \param u8Row Row
+ **
+ ** \param u8Col Column
+ **
+ ** \returns TRUE if the cell has to be sent
+ */
+static boolean_t CellChanged(stc_pcf8574_hd44780_t* pstcLcd, uint8_t u8Row, uint8_t u8Col)
+{
+    return (boolean_t)(((pstcLcd->u8StaleRows & (1 << u8Row)) != 0) ||
+                       (pstcLcd->au8Frame[u8Row][u8Col] != pstcLcd->au8Shown[u8Row][u8Col]));
+}
+
+/**
+ ** \brief Append one byte as two nibbles to the stream
+ **
+ ** Each nibble is one state with E high and one with E low, the LCD
+ ** latches on the falling edge. If RS changes, one state without E is
+ ** sent first as RS setup time.
+ **
+ ** \param pstcLcd Pointer of LCD
+ **
+ ** \param pu32Pos Stream position, incremented
+ **
+ ** \param u8Byte Command or character
+ **
+ ** \param bData TRUE for a character (RS high)
+ **
+ ** \param pu8Last Last port state, updated
+ */
+static void PutByte(stc_pcf8574_hd44780_t* pstcLcd, uint32_t* pu32Pos, uint8_t u8Byte, boolean_t bData, uint8_t* pu8Last)
+{
+    uint8_t u8Base = (uint8_t)((pstcLcd->bBacklight ? PCF8574_HD44780_BACKLIGHT : 0) | (bData ? PCF8574_HD44780_RS : 0));
+    uint8_t u8High = (uint8_t)(u8Base | (u8Byte & 0xF0));
+    uint8_t u8Low = (uint8_t)(u8Base | ((u8Byte << 4) & 0xF0));
+    if (((*pu8Last ^ u8Base) & PCF8574_HD44780_RS) != 0)
+    {
+        pstcLcd->au8Stream[(*pu32Pos)++] = u8High;
+    }
+    pstcLcd->au8Stream[(*pu32Pos)++] = (uint8_t)(u8High | PCF8574_HD44780_E);
+    pstcLcd->au8Stream[(*pu32Pos)++] = u8High;
+    pstcLcd->au8Stream[(*pu32Pos)++] = (uint8_t)(u8Low | PCF8574_HD44780_E);
+    pstcLcd->au8Stream[(*pu32Pos)++] = u8Low;
+    *pu8Last = u8Low;
+}
+
+/**
+ ** \brief Last port state written to the backpack
+ **
+ ** \param pstcLcd Pointer of LCD
+ **
+ ** \returns port state, RS high if unknown so the first command gets its setup state
+ */
+static uint8_t LastState(stc_pcf8574_hd44780_t* pstcLcd)
+{
+    if (!pstcLcd->pHandle->bOutputValid)
+    {
+        return PCF8574_HD44780_RS;
+    }
+    return (uint8_t)pstcLcd->pHandle->portOutputValues;
+}
+
+/**
+ ** \brief Encode all changed cells into the stream and mark them as shown
+ **
+ ** Changed cells separated by one unchanged cell are sent as one run,
+ ** as resending the cell costs the same as a new set-address command.
+ **
+ ** \param pstcLcd Pointer of LCD
+ **
+ ** \returns number of port states, 0 if nothing changed
+ */
+static uint32_t BuildStream(stc_pcf8574_hd44780_t* pstcLcd)
+{
+    uint32_t u32Pos = 0;
+    uint8_t u8Last = LastState(pstcLcd);
+    uint8_t u8Rows = (uint8_t)(pstcLcd->u8DirtyRows | pstcLcd->u8StaleRows);
+    uint8_t u8Row;
+    uint8_t u8Col;
+    uint8_t u8Start;
+    uint8_t u8End;
+    pstcLcd->u8StreamRows = 0;
+    for(u8Row = 0;u8Row < pstcLcd->u8Rows;u8Row++)
+    {
+        if ((u8Rows & (1 << u8Row)) == 0)
+        {
+            continue;
+        }
+        u8Col = 0;
+        while(u8Col < pstcLcd->u8Cols)
+        {
+            if (!CellChanged(pstcLcd,u8Row,u8Col))
+            {
+                u8Col++;
+                continue;
+            }
+            u8Start = u8Col;
+            u8End = u8Col;
+            for(u8Col = (uint8_t)(u8Start + 1);u8Col < pstcLcd->u8Cols;u8Col++)
+            {
+                if (CellChanged(pstcLcd,u8Row,u8Col))
+                {
+                    u8End = u8Col;
+                } else if (((u8Col + 1) >= pstcLcd->u8Cols) || (!CellChanged(pstcLcd,u8Row,(uint8_t)(u8Col + 1))))
+                {
+                    break;
+                }
+            }
+            PutByte(pstcLcd,&u32Pos,(uint8_t)(HD44780_CMD_SET_DDRAM | (RowAddress(pstcLcd,u8Row) + u8Start)),FALSE,&u8Last);
+            for(u8Col = u8Start;u8Col <= u8End;u8Col++)
+            {
+                PutByte(pstcLcd,&u32Pos,pstcLcd->au8Frame[u8Row][u8Col],TRUE,&u8Last);
+                pstcLcd->au8Shown[u8Row][u8Col] = pstcLcd->au8Frame[u8Row][u8Col];
+            }
+            pstcLcd->u8StreamRows |= (uint8_t)(1 << u8Row);
+        }
+    }
+    pstcLcd->u8DirtyRows &= (uint8_t)~u8Rows;
+    pstcLcd->u8StaleRows &= (uint8_t)~u8Rows;
+    return u32Pos;
+}
+
+/**
+ ** \brief Rows of a failed refresh are redrawn completely by the next refresh
+ **
+ ** \param pstcLcd Pointer of LCD
+ */
+static void RefreshFailed(stc_pcf8574_hd44780_t* pstcLcd)
+{
+    pstcLcd->u8StaleRows |= pstcLcd->u8StreamRows;
+    pstcLcd->u8DirtyRows |= pstcLcd->u8StreamRows;
+}
+
+/**
+ ** \brief Send one nibble in 8-bit mode of the power-on sequence
+ **
+ ** \param pstcLcd Pointer of LCD
+ **
+ ** \param u8Nibble Upper nibble of the 8-bit command
+ **
+ ** \returns Ok on success
+ */
+static en_result_t WriteNibble(stc_pcf8574_hd44780_t* pstcLcd, uint8_t u8Nibble)
+{
+    uint8_t u8State = (uint8_t)((pstcLcd->bBacklight ? PCF8574_HD44780_BACKLIGHT : 0) | (u8Nibble & 0xF0));
+    pstcLcd->au8Stream[0] = (uint8_t)(u8State | PCF8574_HD44780_E);
+    pstcLcd->au8Stream[1] = u8State;
+    return Pcf8574_WriteStream(pstcLcd->pHandle,pstcLcd->au8Stream,2);
+}
+
+/**
+ ** \brief Send one command blocking
+ **
+ ** \param pstcLcd Pointer of LCD
+ **
+ ** \param u8Command Command
+ **
+ ** \returns Ok on success
+ */
+static en_result_t WriteCommand(stc_pcf8574_hd44780_t* pstcLcd, uint8_t u8Command)
+{
+    uint32_t u32Pos = 0;
+    uint8_t u8Last = LastState(pstcLcd);
+    PutByte(pstcLcd,&u32Pos,u8Command,FALSE,&u8Last);
+    return Pcf8574_WriteStream(pstcLcd->pHandle,pstcLcd->au8Stream,u32Pos);
+}
+
+/**
+ ** \brief Write done callback of the async refresh
+ **
+ ** \param pHandle PCF8574 handle
+ **
+ ** \param enResult Result of the write
+ */
+static void RefreshDone(void* pHandle, en_result_t enResult)
+{
+    stc_pcf8574_hd44780_t* pstcLcd;
+    pfn_pcf8574_done_t pfnDone;
+    for(pstcLcd = pstcHd44780Root;pstcLcd != NULL;pstcLcd = pstcLcd->Next)
+    {
+        if ((pstcLcd->pHandle == pHandle) && (pstcLcd->bBusy))
+        {
+            break;
+        }
+    }
+    if (pstcLcd == NULL)
+    {
+        return;
+    }
+    if (enResult != Ok)
+    {
+        RefreshFailed(pstcLcd);
+    }
+    pfnDone = pstcLcd->pfnDone;
+    pstcLcd->bBusy = FALSE;
+    if (pfnDone != NULL)
+    {
+        pfnDone(pstcLcd,enResult);
+    }
+}
+
+/**
+ ** \brief Init the LCD in 4-bit mode, clear it and switch the backlight on
+ **
+ ** Runs the power-on sequence of the HD44780 with blocking writes, the
+ ** PCF8574 handle must be initialized. The display is cleared and the
+ ** framebuffer filled with spaces.
+ **
+ ** \param pstcLcd Pointer of LCD
+ **
+ ** \param pstcHandle Pointer of initialized PCF8574 handle (8-bit port)
+ **
+ ** \param u8Cols Columns, 1..PCF8574_HD44780_MAX_COLS
+ **
+ ** \param u8Rows Rows, 1..PCF8574_HD44780_MAX_ROWS
+ **
+ ** \param pfnDelayMs Delay function, example: void DelayMs(uint32_t u32Ms);
+ **
+ ** \returns Ok on success
+ */
+en_result_t Pcf8574Hd44780_Init(stc_pcf8574_hd44780_t* pstcLcd, stc_pcf8574_handle_t* pstcHandle, uint8_t u8Cols, uint8_t u8Rows, pfn_pcf8574_hd44780_delay_t pfnDelayMs)
+{
+    static const uint8_t au8Wakeup[] = { 0x30, 0x30, 0x30, 0x20 };   ///< 8-bit mode three times, then 4-bit mode
+    static const uint8_t au8WakeupDelay[] = { 5, 1, 1, 0 };
+    uint8_t au8Setup[] = { HD44780_CMD_FUNCTION_2LINE, HD44780_CMD_DISPLAY_ON, HD44780_CMD_CLEAR, HD44780_CMD_ENTRY_MODE };
+    en_result_t enResult = Ok;
+    uint32_t i;
+    if ((pstcLcd == NULL) || (pstcHandle == NULL) || (pfnDelayMs == NULL))
+    {
+        return ErrorUninitialized;
+    }
+    if ((u8Cols == 0) || (u8Cols > PCF8574_HD44780_MAX_COLS) ||
+        (u8Rows == 0) || (u8Rows > PCF8574_HD44780_MAX_ROWS) || (pstcHandle->u8PortBits > 8))
+    {
+        return ErrorInvalidParameter;
+    }
+    Pcf8574Hd44780_Deinit(pstcLcd);
+    pstcLcd->pHandle = pstcHandle;
+    pstcLcd->u8Cols = u8Cols;
+    pstcLcd->u8Rows = u8Rows;
+    pstcLcd->bBacklight = TRUE;
+    pstcLcd->u8CursorCol = 0;
+    pstcLcd->u8CursorRow = 0;
+    pstcLcd->u8DirtyRows = 0;
+    pstcLcd->u8StaleRows = 0;
+    pstcLcd->u8StreamRows = 0;
+    pstcLcd->bBusy = FALSE;
+    pstcLcd->pfnDone = NULL;
+    memset(pstcLcd->au8Frame,' ',sizeof(pstcLcd->au8Frame));
+    memset(pstcLcd->au8Shown,' ',sizeof(pstcLcd->au8Shown));
+
+    pfnDelayMs(50);
+    for(i = 0;i < sizeof(au8Wakeup);i++)
+    {
+        if (WriteNibble(pstcLcd,au8Wakeup[i]) != Ok)
+        {
+            enResult = Error;
+        }
+        pfnDelayMs(au8WakeupDelay[i]);
+    }
+    au8Setup[0] = (u8Rows > 1) ? HD44780_CMD_FUNCTION_2LINE : HD44780_CMD_FUNCTION_1LINE;
+    for(i = 0;i < sizeof(au8Setup);i++)
+    {
+        if (WriteCommand(pstcLcd,au8Setup[i]) != Ok)
+        {
+            enResult = Error;
+        }
+        if (au8Setup[i] == HD44780_CMD_CLEAR)
+        {
+            pfnDelayMs(2);
+        }
+    }
+    if (enResult != Ok)
+    {
+        pstcLcd->u8StaleRows = (uint8_t)((1 << u8Rows) - 1);
+        return Error;
+    }
+
+    pstcLcd->Next = pstcHd44780Root;
+    pstcHd44780Root = pstcLcd;
+    return Ok;
+}
+
+/**
+ ** \brief Deinit the LCD, the display content is kept
+ **
+ ** \param pstcLcd Pointer of LCD
+ **
+ ** \returns Ok on success
+ */
+en_result_t Pcf8574Hd44780_Deinit(stc_pcf8574_hd44780_t* pstcLcd)
+{
+    stc_pcf8574_hd44780_t** ppstcCurrent = &pstcHd44780Root;
+    if (pstcLcd == NULL)
+    {
+        return ErrorUninitialized;
+    }
+    while(*ppstcCurrent != NULL)
+    {
+        if (*ppstcCurrent == pstcLcd)
+        {
+            *ppstcCurrent = pstcLcd->Next;
+            break;
+        }
+        ppstcCurrent = &((*ppstcCurrent)->Next);
+    }
+    pstcLcd->Next = NULL;
+    return Ok;
+}
+
+/**
+ ** \brief Switch the backlight, written immediately
+ **
+ ** \param pstcLcd Pointer of LCD
+ **
+ ** \param bOn TRUE for on
+ **
+ ** \returns Ok on success, Error if the write failed
+ */
+en_result_t Pcf8574Hd44780_SetBacklight(stc_pcf8574_hd44780_t* pstcLcd, boolean_t bOn)
+{
+    if ((pstcLcd == NULL) || (pstcLcd->pHandle == NULL))
+    {
+        return ErrorUninitialized;
+    }
+    if (pstcLcd->bBusy)
+    {
+        return ErrorOperationInProgress;
+    }
+    pstcLcd->bBacklight = bOn;
+    Pcf8574_Write(pstcLcd->pHandle,(pcf8574_port_t)(bOn ? PCF8574_HD44780_BACKLIGHT : 0));
+    return (pstcLcd->pHandle->bOutputValid) ? Ok : Error;
+}
+
+/**
+ ** \brief Set the framebuffer position of the next Pcf8574Hd44780_Print()
+ **
+ ** \param pstcLcd Pointer of LCD
+ **
+ ** \param u8Col Column
+ **
+ ** \param u8Row Row
+ **
+ ** \returns Ok on success
+ */
+en_result_t Pcf8574Hd44780_SetCursor(stc_pcf8574_hd44780_t* pstcLcd, uint8_t u8Col, uint8_t u8Row)
+{
+    if (pstcLcd == NULL)
+    {
+        return ErrorUninitialized;
+    }
+    if ((u8Col >= pstcLcd->u8Cols) || (u8Row >= pstcLcd->u8Rows))
+    {
+        return ErrorInvalidParameter;
+    }
+    pstcLcd->u8CursorCol = u8Col;
+    pstcLcd->u8CursorRow = u8Row;
+    return Ok;
+}
+
+/**
+ ** \brief Write text into the framebuffer at the cursor
+ **
+ ** Text behind the end of the row is dropped, '\n' continues at the
+ ** first column of the next row.
+ **
+ ** \param pstcLcd Pointer of LCD
+ **
+ ** \param pcText Zero terminated text
+ */
+void Pcf8574Hd44780_Print(stc_pcf8574_hd44780_t* pstcLcd, const char* pcText)
+{
+    if ((pstcLcd == NULL) || (pcText == NULL))
+    {
+        return;
+    }
+    for(;*pcText != '\0';pcText++)
+    {
+        if (*pcText == '\n')
+        {
+            pstcLcd->u8CursorCol = 0;
+            if ((pstcLcd->u8CursorRow + 1) < pstcLcd->u8Rows)
+            {
+                pstcLcd->u8CursorRow++;
+            }
+            continue;
+        }
+        if (pstcLcd->u8CursorCol < pstcLcd->u8Cols)
+        {
+            Pcf8574Hd44780_PutChar(pstcLcd,pstcLcd->u8CursorCol,pstcLcd->u8CursorRow,(uint8_t)*pcText);
+            pstcLcd->u8CursorCol++;
+        }
+    }
+}
+
+/**
+ ** \brief Write one character into the framebuffer
+ **
+ ** \param pstcLcd Pointer of LCD
+ **
+ ** \param u8Col Column
+ **
+ ** \param u8Row Row
+ **
+ ** \param u8Char Character code of the LCD
+ **
+ ** \returns Ok on success
+ */
+en_result_t Pcf8574Hd44780_PutChar(stc_pcf8574_hd44780_t* pstcLcd, uint8_t u8Col, uint8_t u8Row, uint8_t u8Char)
+{
+    if (pstcLcd == NULL)
+    {
+        return ErrorUninitialized;
+    }
+    if ((u8Col >= pstcLcd->u8Cols) || (u8Row >= pstcLcd->u8Rows))
+    {
+        return ErrorInvalidParameter;
+    }
+    if (pstcLcd->au8Frame[u8Row][u8Col] != u8Char)
+    {
+        pstcLcd->au8Frame[u8Row][u8Col] = u8Char;
+        pstcLcd->u8DirtyRows |= (uint8_t)(1 << u8Row);
+    }
+    return Ok;
+}
+
+/**
+ ** \brief Fill the framebuffer with spaces and move the cursor home
+ **
+ ** \param pstcLcd Pointer of LCD
+ */
+void Pcf8574Hd44780_Clear(stc_pcf8574_hd44780_t* pstcLcd)
+{
+    if (pstcLcd == NULL)
+    {
+        return;
+    }
+    memset(pstcLcd->au8Frame,' ',sizeof(pstcLcd->au8Frame));
+    pstcLcd->u8DirtyRows = (uint8_t)((1 << pstcLcd->u8Rows) - 1);
+    pstcLcd->u8CursorCol = 0;
+    pstcLcd->u8CursorRow = 0;
+}
+
+/**
+ ** \brief Send the changed cells of the framebuffer in one blocking stream
+ **
+ ** \param pstcLcd Pointer of LCD
+ **
+ ** \returns Ok on success, the failed rows are redrawn by the next refresh
+ */
+en_result_t Pcf8574Hd44780_Refresh(stc_pcf8574_hd44780_t* pstcLcd)
+{
+    uint32_t u32Len;
+    if ((pstcLcd == NULL) || (pstcLcd->pHandle == NULL))
+    {
+        return ErrorUninitialized;
+    }
+    if (pstcLcd->bBusy)
+    {
+        return ErrorOperationInProgress;
+    }
+    u32Len = BuildStream(pstcLcd);
+    if (u32Len == 0)
+    {
+        return Ok;
+    }
+    if (Pcf8574_WriteStream(pstcLcd->pHandle,pstcLcd->au8Stream,u32Len) != Ok)
+    {
+        RefreshFailed(pstcLcd);
+        return Error;
+    }
+    return Ok;
+}
+
+/**
+ ** \brief Send the changed cells of the framebuffer non-blocking (requires pstcBus)
+ **
+ ** The framebuffer can be written while the refresh is running, the
+ ** changes are sent by the next refresh.
+ **
+ ** \param pstcLcd Pointer of LCD
+ **
+ ** \param pfnDone Done callback or NULL, pHandle is the LCD, called immediately if nothing changed
+ **
+ ** \returns Ok if the refresh was started
+ */
+en_result_t Pcf8574Hd44780_RefreshAsync(stc_pcf8574_hd44780_t* pstcLcd, pfn_pcf8574_done_t pfnDone)
+{
+    uint32_t u32Len;
+    en_result_t enResult;
+    if ((pstcLcd == NULL) || (pstcLcd->pHandle == NULL) || (pstcLcd->pHandle->pstcBus == NULL))
+    {
+        return ErrorUninitialized;
+    }
+    if (pstcLcd->bBusy)
+    {
+        return ErrorOperationInProgress;
+    }
+    u32Len = BuildStream(pstcLcd);
+    if (u32Len == 0)
+    {
+        if (pfnDone != NULL)
+        {
+            pfnDone(pstcLcd,Ok);
+        }
+        return Ok;
+    }
+    pstcLcd->pfnDone = pfnDone;
+    pstcLcd->bBusy = TRUE;
+    enResult = Pcf8574_WriteStreamAsync(pstcLcd->pHandle,pstcLcd->au8Stream,u32Len,RefreshDone);
+    if (enResult != Ok)
+    {
+        pstcLcd->bBusy = FALSE;
+        RefreshFailed(pstcLcd);
+    }
+    return enResult;
+}
+
+/**
+ *******************************************************************************
+ ** EOF (not truncated)
+ *******************************************************************************
+ */
@@ -0,0 +1,178 @@
+/**
+ *******************************************************************************
+ ** Created by the pcf8574 contributors
+ **
+ ** Copyright © 2026 pcf8574 contributors. All rights reserved.
+ **
+ ** 1. Redistributions of source code must retain the above copyright notice,
+ **    this condition and the following disclaimer.
+ **
+ ** This software is provided by the copyright holder and contributors "AS IS"
+ ** and any warranties related to this software are DISCLAIMED.
+ ** The copyright owner or contributors be NOT LIABLE for any damages caused
+ ** by use of this software.
+
+ *******************************************************************************
+ */
+
+/**
+ *******************************************************************************
+ **\file pcf8574_hd44780.h
+ **
+ ** HD44780 character LCD on a PCF8574 backpack
+ ** A detailed description is available at
+ ** @link Pcf8574Hd44780Group file description @endlink
+ **
+ ** History:
+ ** - 2026-10-16 1.00  First version
+ *******************************************************************************
+ */
+
+#if !defined(__PCF8574_HD44780_H__)
+#define __PCF8574_HD44780_H__
+
+/* C binding of definitions if building with C++ compiler */
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ *******************************************************************************
+ ** \defgroup Pcf8574Hd44780Group HD44780 character LCD on a PCF8574 backpack
+ **
+ ** The LCD is driven in 4-bit mode. Text is written into a framebuffer,
+ ** Pcf8574Hd44780_Refresh() sends only the changed cells: every run of
+ ** changed cells is one set-address command followed by the characters,
+ ** each nibble is encoded as two port states (E high, E low) and the
+ ** whole refresh is sent with one Pcf8574_WriteStream() transaction.
+ ** The data is latched on the falling edge of E, one port state takes
+ ** one I2C byte (90 us at 100 kHz), so the LCD timing is met by the bus
+ ** itself up to 400 kHz.
+ **
+ *******************************************************************************
+ */
+
+//@{
+
+/**
+ *******************************************************************************
+ ** \page pcf8574_hd44780_example Example of LCD usage
+ ** \brief Following code gives some short example
+ ** @code
+ ** #include "pcf8574_hd44780.h"
+ **
+ ** stc_pcf8574_hd44780_t stcLcd;
+ **
+ **     Pcf8574_Init(&stcPcf8574,NULL);
+ **     Pcf8574Hd44780_Init(&stcLcd,&stcPcf8574,20,4,HAL_DelayMs);
+ **     Pcf8574Hd44780_SetCursor(&stcLcd,0,1);
+ **     Pcf8574Hd44780_Print(&stcLcd,"Hello World");
+ **     Pcf8574Hd44780_Refresh(&stcLcd);    //one transaction for all changed cells
+ ** @endcode
+ **
+ *******************************************************************************
+ */
+
+/**
+ *******************************************************************************
+ ** (Global) Include files
+ *******************************************************************************
+ */
+
+#include "base_types.h"
+#include "pcf8574.h"
+
+/**
+ *******************************************************************************
+ ** Global pre-processor symbols/macros ('#define')
+ *******************************************************************************
+ */
+
+ /** Largest supported display */
+ #if !defined(PCF8574_HD44780_MAX_COLS)
+ #define PCF8574_HD44780_MAX_COLS 20
+ #endif
+ #if !defined(PCF8574_HD44780_MAX_ROWS)
+ #define PCF8574_HD44780_MAX_ROWS 4
+ #endif
+
+ /** Backpack wiring, GPIO masks of the control lines, D4..D7 at GPIO4..GPIO7 */
+ #if !defined(PCF8574_HD44780_RS)
+ #define PCF8574_HD44780_RS 0x01
+ #endif
+ #if !defined(PCF8574_HD44780_RW)
+ #define PCF8574_HD44780_RW 0x02
+ #endif
+ #if !defined(PCF8574_HD44780_E)
+ #define PCF8574_HD44780_E 0x04
+ #endif
+ #if !defined(PCF8574_HD44780_BACKLIGHT)
+ #define PCF8574_HD44780_BACKLIGHT 0x08
+ #endif
+
+ /** Port states of the worst case refresh: per row one address command, RS setup states and 4 states per cell */
+ #define PCF8574_HD44780_STREAM_SIZE (PCF8574_HD44780_MAX_ROWS * (PCF8574_HD44780_MAX_COLS * 4 + 6))
+
+/**
+ *******************************************************************************
+ ** Global type definitions ('typedef')
+ *******************************************************************************
+ */
+
+/**
+ ** \brief Delay callback used by the power-on sequence of Pcf8574Hd44780_Init()
+ */
+typedef void (*pfn_pcf8574_hd44780_delay_t)  (uint32_t u32Ms);
+
+/**
+ ** \brief HD44780 LCD handle
+ */
+typedef struct stc_pcf8574_hd44780
+{
+    stc_pcf8574_handle_t* pHandle;     ///< PCF8574 of the backpack
+    uint8_t u8Cols;
+    uint8_t u8Rows;
+    boolean_t bBacklight;
+    uint8_t u8CursorCol;               ///< framebuffer position of the next Pcf8574Hd44780_Print()
+    uint8_t u8CursorRow;
+    uint8_t u8DirtyRows;               ///< rows with changed cells, one bit per row
+    uint8_t u8StaleRows;               ///< rows with unknown display content, redrawn completely
+    uint8_t u8StreamRows;              ///< rows sent by the running async refresh
+    volatile boolean_t bBusy;          ///< async refresh in progress
+    pfn_pcf8574_done_t pfnDone;        ///< done callback of the async refresh, pHandle is the LCD
+    uint8_t au8Frame[PCF8574_HD44780_MAX_ROWS][PCF8574_HD44780_MAX_COLS]; ///< characters to display
+    uint8_t au8Shown[PCF8574_HD44780_MAX_ROWS][PCF8574_HD44780_MAX_COLS]; ///< characters on the display
+    uint8_t au8Stream[PCF8574_HD44780_STREAM_SIZE];
+    struct stc_pcf8574_hd44780* Next;
+} stc_pcf8574_hd44780_t;
+
+/**
+ *******************************************************************************
+ ** Global function prototypes ('extern', definition in C source)
+ *******************************************************************************
+ */
+
+en_result_t Pcf8574Hd44780_Init(stc_pcf8574_hd44780_t* pstcLcd, stc_pcf8574_handle_t* pstcHandle, uint8_t u8Cols, uint8_t u8Rows, pfn_pcf8574_hd44780_delay_t pfnDelayMs);
+en_result_t Pcf8574Hd44780_Deinit(stc_pcf8574_hd44780_t* pstcLcd);
+en_result_t Pcf8574Hd44780_SetBacklight(stc_pcf8574_hd44780_t* pstcLcd, boolean_t bOn);
+en_result_t Pcf8574Hd44780_SetCursor(stc_pcf8574_hd44780_t* pstcLcd, uint8_t u8Col, uint8_t u8Row);
+void Pcf8574Hd44780_Print(stc_pcf8574_hd44780_t* pstcLcd, const char* pcText);
+en_result_t Pcf8574Hd44780_PutChar(stc_pcf8574_hd44780_t* pstcLcd, uint8_t u8Col, uint8_t u8Row, uint8_t u8Char);
+void Pcf8574Hd44780_Clear(stc_pcf8574_hd44780_t* pstcLcd);
+en_result_t Pcf8574Hd44780_Refresh(stc_pcf8574_hd44780_t* pstcLcd);
+en_result_t Pcf8574Hd44780_RefreshAsync(stc_pcf8574_hd44780_t* pstcLcd, pfn_pcf8574_done_t pfnDone);
+
+//@} // Pcf8574Hd44780Group
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __PCF8574_HD44780_H__ */
+
+/**
+ *******************************************************************************
+ ** EOF (not truncated)
+ *******************************************************************************
+ */
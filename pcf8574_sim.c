@@ -0,0 +1,612 @@
+/**
+ *******************************************************************************
+ ** Created by the pcf8574 contributors
+ **
+ ** Copyright © 2026 pcf8574 contributors. All rights reserved.
+ **
+ ** 1. Redistributions of source code must retain the above copyright notice,
+ **    this condition and the following disclaimer.
+ **
+ ** This software is provided by the copyright holder and contributors "AS IS"
+ ** and any warranties related to this software are DISCLAIMED.
+ ** The copyright owner or contributors be NOT LIABLE for any damages caused
+ ** by use of this software.
+
+ *******************************************************************************
+ */
+
+/**
+ *******************************************************************************
+ **\file pcf8574_sim.c
+ **
+ ** Simulated PCF8574 / PCF8575 devices and I2C bus for host-side testing
+ ** A detailed description is available at
+ ** @link Pcf8574SimGroup file description @endlink
+ **
+ ** History:
+ ** - 2026-10-16 1.00  First version
+ *******************************************************************************
+ */
+
+#define __PCF8574_SIM_C__
+
+/**
+ *******************************************************************************
+ ** Include files
+ *******************************************************************************
+ */
+
+
+#include "base_types.h"
+#include "pcf8574_sim.h"
+
+/**
+ *******************************************************************************
+ ** Local pre-processor symbols/macros ('#define')
+ *******************************************************************************
+ */
+
+/** SCL cycles of start and stop condition */
+#define PCF8574_SIM_START_BITS 1
+#define PCF8574_SIM_STOP_BITS  1
+/** SCL cycles of one byte including acknowledge */
+#define PCF8574_SIM_BYTE_BITS  9
+
+/**
+ *******************************************************************************
+ ** Local function prototypes ('static')
+ *******************************************************************************
+ */
+
+static stc_pcf8574_sim_device_t* BusAddress(stc_pcf8574_sim_bus_t* pstcBus, uint32_t u32Address);
+static void ReadData(stc_pcf8574_sim_bus_t* pstcBus, stc_pcf8574_sim_device_t* pstcDevice, uint8_t* pu8Data, uint32_t u32Len);
+static void WriteData(stc_pcf8574_sim_bus_t* pstcBus, stc_pcf8574_sim_device_t* pstcDevice, uint8_t* pu8Data, uint32_t u32Len);
+
+/**
+ *******************************************************************************
+ ** Function implementation - global ('extern') and local ('static')
+ *******************************************************************************
+ */
+
+/**
+ ** \brief Port width of a simulated device in bytes
+ **
+ ** \param pstcDevice Pointer of device
+ **
+ ** \returns 1 or 2
+ */
+static uint8_t DeviceBytes(stc_pcf8574_sim_device_t* pstcDevice)
+{
+    return (uint8_t)((pstcDevice->u8PortBits + 7) / 8);
+}
+
+/**
+ ** \brief Bus time of a number of SCL cycles
+ **
+ ** \param pstcBus Pointer of bus
+ **
+ ** \param u32Bits SCL cycles
+ **
+ ** \returns time in ns
+ */
+static uint64_t BitsNs(stc_pcf8574_sim_bus_t* pstcBus, uint32_t u32Bits)
+{
+    return ((uint64_t)u32Bits * 1000000000ULL) / pstcBus->u32BitRate;
+}
+
+/**
+ ** \brief Recalculate INT of all devices and the shared INT line
+ **
+ ** \param pstcBus Pointer of bus
+ */
+static void UpdateInt(stc_pcf8574_sim_bus_t* pstcBus)
+{
+    stc_pcf8574_sim_device_t* pstcDevice;
+    boolean_t bInt = FALSE;
+    for(pstcDevice = pstcBus->pstcDevices;pstcDevice != NULL;pstcDevice = pstcDevice->Next)
+    {
+        if (Pcf8574Sim_GetPins(pstcDevice) != pstcDevice->portLastRead)
+        {
+            if (!pstcDevice->bInt)
+            {
+                pstcDevice->u64IntTimeNs = pstcBus->u64TimeNs;
+            }
+            pstcDevice->bInt = TRUE;
+        } else
+        {
+            pstcDevice->bInt = FALSE;
+        }
+        bInt |= pstcDevice->bInt;
+    }
+    pstcBus->bInt = bInt;
+    if (!bInt)
+    {
+        pstcBus->bIntNotified = FALSE;
+    }
+}
+
+/**
+ ** \brief Move bus time forward and apply all scripted steps until then
+ **
+ ** \param pstcBus Pointer of bus
+ **
+ ** \param u64TimeNs New bus time
+ */
+static void AdvanceTo(stc_pcf8574_sim_bus_t* pstcBus, uint64_t u64TimeNs)
+{
+    stc_pcf8574_sim_device_t* pstcDevice;
+    stc_pcf8574_sim_device_t* pstcNext;
+    const stc_pcf8574_sim_step_t* pstcStep;
+    while(1)
+    {
+        pstcNext = NULL;
+        for(pstcDevice = pstcBus->pstcDevices;pstcDevice != NULL;pstcDevice = pstcDevice->Next)
+        {
+            if ((pstcDevice->pastcSteps == NULL) || (pstcDevice->u32StepIndex >= pstcDevice->u32StepCount))
+            {
+                continue;
+            }
+            pstcStep = &pstcDevice->pastcSteps[pstcDevice->u32StepIndex];
+            if ((pstcStep->u64TimeNs <= u64TimeNs) &&
+                ((pstcNext == NULL) || (pstcStep->u64TimeNs < pstcNext->pastcSteps[pstcNext->u32StepIndex].u64TimeNs)))
+            {
+                pstcNext = pstcDevice;
+            }
+        }
+        if (pstcNext == NULL)
+        {
+            break;
+        }
+        pstcStep = &pstcNext->pastcSteps[pstcNext->u32StepIndex++];
+        if (pstcStep->u64TimeNs > pstcBus->u64TimeNs)
+        {
+            pstcBus->u64TimeNs = pstcStep->u64TimeNs;
+        }
+        pstcNext->portDriveMask = pstcStep->portDriveMask;
+        pstcNext->portDriveValue = pstcStep->portDriveValue;
+        UpdateInt(pstcBus);
+    }
+    if (u64TimeNs > pstcBus->u64TimeNs)
+    {
+        pstcBus->u64TimeNs = u64TimeNs;
+    }
+}
+
+/**
+ ** \brief Spend SCL cycles on the bus
+ **
+ ** \param pstcBus Pointer of bus
+ **
+ ** \param u32Bits SCL cycles
+ */
+static void BusCycles(stc_pcf8574_sim_bus_t* pstcBus, uint32_t u32Bits)
+{
+    uint64_t u64Ns = BitsNs(pstcBus,u32Bits);
+    pstcBus->u64BusyNs += u64Ns;
+    AdvanceTo(pstcBus,pstcBus->u64TimeNs + u64Ns);
+}
+
+/**
+ ** \brief Start a transaction: start condition and address byte
+ **
+ ** \param pstcBus Pointer of bus
+ **
+ ** \param u32Address 7-bit address
+ **
+ ** \returns addressed device, NULL if NACKed
+ */
+static stc_pcf8574_sim_device_t* BusStart(stc_pcf8574_sim_bus_t* pstcBus, uint32_t u32Address)
+{
+    pstcBus->u32Transactions++;
+    return BusAddress(pstcBus,u32Address);
+}
+
+/**
+ ** \brief Start or repeated start condition and address byte
+ **
+ ** \param pstcBus Pointer of bus
+ **
+ ** \param u32Address 7-bit address
+ **
+ ** \returns addressed device, NULL if NACKed (the transaction is stopped)
+ */
+static stc_pcf8574_sim_device_t* BusAddress(stc_pcf8574_sim_bus_t* pstcBus, uint32_t u32Address)
+{
+    stc_pcf8574_sim_device_t* pstcDevice;
+    pstcBus->u32Bytes++;
+    BusCycles(pstcBus,PCF8574_SIM_START_BITS + PCF8574_SIM_BYTE_BITS);
+    for(pstcDevice = pstcBus->pstcDevices;pstcDevice != NULL;pstcDevice = pstcDevice->Next)
+    {
+        if (pstcDevice->u32Address == u32Address)
+        {
+            break;
+        }
+    }
+    if ((pstcDevice != NULL) && (pstcDevice->u32NackCount > 0))
+    {
+        pstcDevice->u32NackCount--;
+        pstcDevice = NULL;
+    }
+    if (pstcDevice == NULL)
+    {
+        pstcBus->u32Nacks++;
+        BusCycles(pstcBus,PCF8574_SIM_STOP_BITS);
+    }
+    return pstcDevice;
+}
+
+/**
+ ** \brief Init a simulated bus
+ **
+ ** \param pstcBus Pointer of bus
+ **
+ ** \param u32BitRate SCL frequency in Hz, e.g. PCF8574_SIM_400KHZ
+ **
+ ** \param pfnIntCallback Called when the shared INT line is asserted, NULL if not used
+ **
+ ** \returns Ok on success
+ */
+en_result_t Pcf8574Sim_InitBus(stc_pcf8574_sim_bus_t* pstcBus, uint32_t u32BitRate, pfn_pcf8574_sim_int_t pfnIntCallback)
+{
+    if (pstcBus == NULL)
+    {
+        return ErrorUninitialized;
+    }
+    if (u32BitRate == 0)
+    {
+        return ErrorInvalidParameter;
+    }
+    memset(pstcBus,0,sizeof(stc_pcf8574_sim_bus_t));
+    pstcBus->u32BitRate = u32BitRate;
+    pstcBus->pfnIntCallback = pfnIntCallback;
+    return Ok;
+}
+
+/**
+ ** \brief Init a simulated device and attach it to a bus
+ **
+ ** The latch is all high after power-on, nothing is driven externally.
+ ** A device already attached to the bus is reset and attached once.
+ **
+ ** \param pstcBus Pointer of bus
+ **
+ ** \param pstcDevice Pointer of device
+ **
+ ** \param u32Address 7-bit address
+ **
+ ** \param u8PortBits 8 for PCF8574, 16 for PCF8575
+ **
+ ** \returns Ok on success
+ */
+en_result_t Pcf8574Sim_InitDevice(stc_pcf8574_sim_bus_t* pstcBus, stc_pcf8574_sim_device_t* pstcDevice, uint32_t u32Address, uint8_t u8PortBits)
+{
+    stc_pcf8574_sim_device_t** ppstcCurrent;
+    if ((pstcBus == NULL) || (pstcDevice == NULL))
+    {
+        return ErrorUninitialized;
+    }
+    if ((u8PortBits != 8) && (u8PortBits != 16))
+    {
+        return ErrorInvalidParameter;
+    }
+    if (u8PortBits > PCF8574_MAX_PORT_BITS)
+    {
+        return ErrorInvalidParameter;
+    }
+    for(ppstcCurrent = &pstcBus->pstcDevices;*ppstcCurrent != NULL;ppstcCurrent = &((*ppstcCurrent)->Next))
+    {
+        if (*ppstcCurrent == pstcDevice)
+        {
+            *ppstcCurrent = pstcDevice->Next;    //init again, unlink before it is added again
+            break;
+        }
+    }
+    memset(pstcDevice,0,sizeof(stc_pcf8574_sim_device_t));
+    pstcDevice->u32Address = u32Address;
+    pstcDevice->u8PortBits = u8PortBits;
+    pstcDevice->portLatch = (pcf8574_port_t)(((uint32_t)1 << u8PortBits) - 1);
+    pstcDevice->portLastRead = pstcDevice->portLatch;
+    pstcDevice->Next = pstcBus->pstcDevices;
+    pstcBus->pstcDevices = pstcDevice;
+    return Ok;
+}
+
+/**
+ ** \brief Set the scripted input waveform of a device
+ **
+ ** \param pstcDevice Pointer of device
+ **
+ ** \param pastcSteps Steps sorted by time, NULL to remove
+ **
+ ** \param u32Count Number of steps
+ **
+ ** \returns Ok on success
+ */
+en_result_t Pcf8574Sim_SetWaveform(stc_pcf8574_sim_device_t* pstcDevice, const stc_pcf8574_sim_step_t* pastcSteps, uint32_t u32Count)
+{
+    if (pstcDevice == NULL)
+    {
+        return ErrorUninitialized;
+    }
+    pstcDevice->pastcSteps = pastcSteps;
+    pstcDevice->u32StepCount = (pastcSteps != NULL) ? u32Count : 0;
+    pstcDevice->u32StepIndex = 0;
+    return Ok;
+}
+
+/**
+ ** \brief Change the external driver of a device now
+ **
+ ** \param pstcBus Pointer of bus
+ **
+ ** \param pstcDevice Pointer of device
+ **
+ ** \param portDriveMask GPIOs driven externally
+ **
+ ** \param portDriveValue Levels of the driven GPIOs
+ */
+void Pcf8574Sim_Drive(stc_pcf8574_sim_bus_t* pstcBus, stc_pcf8574_sim_device_t* pstcDevice, pcf8574_port_t portDriveMask, pcf8574_port_t portDriveValue)
+{
+    pstcDevice->portDriveMask = portDriveMask;
+    pstcDevice->portDriveValue = portDriveValue;
+    UpdateInt(pstcBus);
+    Pcf8574Sim_Advance(pstcBus,0);
+}
+
+/**
+ ** \brief NACK the next transfers of a device
+ **
+ ** \param pstcDevice Pointer of device
+ **
+ ** \param u32Count Number of transfers
+ */
+void Pcf8574Sim_InjectNack(stc_pcf8574_sim_device_t* pstcDevice, uint32_t u32Count)
+{
+    pstcDevice->u32NackCount = u32Count;
+}
+
+/**
+ ** \brief Run the simulation for some time
+ **
+ ** Scripted steps are applied in time order. The INT callback is called
+ ** once per assertion of the shared INT line (falling edge), transfers
+ ** done by the callback take bus time as well.
+ **
+ ** \param pstcBus Pointer of bus
+ **
+ ** \param u64Ns Time to run in ns, 0 only handles a pending INT
+ */
+void Pcf8574Sim_Advance(stc_pcf8574_sim_bus_t* pstcBus, uint64_t u64Ns)
+{
+    uint64_t u64Target = pstcBus->u64TimeNs + u64Ns;
+    stc_pcf8574_sim_device_t* pstcDevice;
+    uint64_t u64Next;
+    while(1)
+    {
+        if ((pstcBus->bInt) && (!pstcBus->bIntNotified) && (!pstcBus->bInCallback) && (pstcBus->pfnIntCallback != NULL))
+        {
+            pstcBus->bIntNotified = TRUE;
+            pstcBus->bInCallback = TRUE;
+            pstcBus->pfnIntCallback(pstcBus);
+            pstcBus->bInCallback = FALSE;
+            continue;
+        }
+        u64Next = u64Target;
+        for(pstcDevice = pstcBus->pstcDevices;pstcDevice != NULL;pstcDevice = pstcDevice->Next)
+        {
+            if ((pstcDevice->pastcSteps != NULL) && (pstcDevice->u32StepIndex < pstcDevice->u32StepCount) &&
+                (pstcDevice->pastcSteps[pstcDevice->u32StepIndex].u64TimeNs < u64Next))
+            {
+                u64Next = pstcDevice->pastcSteps[pstcDevice->u32StepIndex].u64TimeNs;
+            }
+        }
+        AdvanceTo(pstcBus,u64Next);
+        if (u64Next >= u64Target)
+        {
+            break;
+        }
+    }
+}
+
+/**
+ ** \brief GPIO levels of a device
+ **
+ ** A GPIO with latch 0 is driven low, a GPIO with latch 1 follows the
+ ** external driver or is pulled high.
+ **
+ ** \param pstcDevice Pointer of device
+ **
+ ** \returns GPIO levels
+ */
+pcf8574_port_t Pcf8574Sim_GetPins(stc_pcf8574_sim_device_t* pstcDevice)
+{
+    return (pcf8574_port_t)(pstcDevice->portLatch & (~pstcDevice->portDriveMask | pstcDevice->portDriveValue));
+}
+
+/**
+ ** \brief State of the shared INT line
+ **
+ ** \param pstcBus Pointer of bus
+ **
+ ** \returns TRUE if asserted (low)
+ */
+boolean_t Pcf8574Sim_GetInt(stc_pcf8574_sim_bus_t* pstcBus)
+{
+    return pstcBus->bInt;
+}
+
+/**
+ ** \brief Bus time
+ **
+ ** \param pstcBus Pointer of bus
+ **
+ ** \returns time in ns
+ */
+uint64_t Pcf8574Sim_GetTimeNs(stc_pcf8574_sim_bus_t* pstcBus)
+{
+    return pstcBus->u64TimeNs;
+}
+
+/**
+ ** \brief Bus time of a complete transaction
+ **
+ ** \param pstcBus Pointer of bus
+ **
+ ** \param u32Len Data bytes
+ **
+ ** \returns time in ns
+ */
+uint64_t Pcf8574Sim_TransferTimeNs(stc_pcf8574_sim_bus_t* pstcBus, uint32_t u32Len)
+{
+    return BitsNs(pstcBus,PCF8574_SIM_START_BITS + PCF8574_SIM_BYTE_BITS * (u32Len + 1) + PCF8574_SIM_STOP_BITS);
+}
+
+/**
+ ** \brief Read transport of type pfn_pcf8574_i2c_read_t, pHandle is the simulated bus
+ **
+ ** The GPIOs are sampled at the acknowledge of every byte, the INT of the
+ ** device is cleared.
+ **
+ ** \returns 0 on success, -1 on NACK
+ */
+int Pcf8574Sim_Read(void* pHandle, uint32_t u32Address, uint8_t* pu8Data, uint32_t u32Len)
+{
+    stc_pcf8574_sim_bus_t* pstcBus = (stc_pcf8574_sim_bus_t*)pHandle;
+    stc_pcf8574_sim_device_t* pstcDevice = BusStart(pstcBus,u32Address);
+    if (pstcDevice == NULL)
+    {
+        return -1;
+    }
+    ReadData(pstcBus,pstcDevice,pu8Data,u32Len);
+    BusCycles(pstcBus,PCF8574_SIM_STOP_BITS);
+    return 0;
+}
+
+/**
+ ** \brief Data phase of a read from a device
+ **
+ ** \param pstcBus Pointer of bus
+ **
+ ** \param pstcDevice Addressed device
+ **
+ ** \param pu8Data Read data
+ **
+ ** \param u32Len Data bytes
+ */
+static void ReadData(stc_pcf8574_sim_bus_t* pstcBus, stc_pcf8574_sim_device_t* pstcDevice, uint8_t* pu8Data, uint32_t u32Len)
+{
+    pcf8574_port_t portPins = 0;
+    uint32_t i;
+    pstcDevice->u32Reads++;
+    for(i = 0;i < u32Len;i++)
+    {
+        BusCycles(pstcBus,PCF8574_SIM_BYTE_BITS);
+        if ((i % DeviceBytes(pstcDevice)) == 0)
+        {
+            portPins = Pcf8574Sim_GetPins(pstcDevice);
+            pstcDevice->portLastRead = portPins;
+            UpdateInt(pstcBus);
+        }
+        pu8Data[i] = (uint8_t)(portPins >> (8 * (i % DeviceBytes(pstcDevice))));
+    }
+    pstcBus->u32Bytes += u32Len;
+    pstcDevice->u32Bytes += u32Len;
+}
+
+/**
+ ** \brief Write transport of type pfn_pcf8574_i2c_write_t, pHandle is the simulated bus
+ **
+ ** The latch is updated at the acknowledge of every port value (every
+ ** byte for PCF8574, every second byte for PCF8575), the INT of the device
+ ** is cleared.
+ **
+ ** \returns 0 on success, -1 on NACK
+ */
+int Pcf8574Sim_Write(void* pHandle, uint32_t u32Address, uint8_t* pu8Data, uint32_t u32Len)
+{
+    stc_pcf8574_sim_bus_t* pstcBus = (stc_pcf8574_sim_bus_t*)pHandle;
+    stc_pcf8574_sim_device_t* pstcDevice = BusStart(pstcBus,u32Address);
+    if (pstcDevice == NULL)
+    {
+        return -1;
+    }
+    WriteData(pstcBus,pstcDevice,pu8Data,u32Len);
+    BusCycles(pstcBus,PCF8574_SIM_STOP_BITS);
+    return 0;
+}
+
+/**
+ ** \brief Data phase of a write to a device
+ **
+ ** \param pstcBus Pointer of bus
+ **
+ ** \param pstcDevice Addressed device
+ **
+ ** \param pu8Data Data to write
+ **
+ ** \param u32Len Data bytes
+ */
+static void WriteData(stc_pcf8574_sim_bus_t* pstcBus, stc_pcf8574_sim_device_t* pstcDevice, uint8_t* pu8Data, uint32_t u32Len)
+{
+    pcf8574_port_t portValue = 0;
+    uint8_t u8Byte;
+    uint32_t i;
+    pstcDevice->u32Writes++;
+    for(i = 0;i < u32Len;i++)
+    {
+        BusCycles(pstcBus,PCF8574_SIM_BYTE_BITS);
+        u8Byte = (uint8_t)(i % DeviceBytes(pstcDevice));
+        if (u8Byte == 0)
+        {
+            portValue = 0;
+        }
+        portValue |= (pcf8574_port_t)((pcf8574_port_t)pu8Data[i] << (8 * u8Byte));
+        if (u8Byte == (DeviceBytes(pstcDevice) - 1))
+        {
+            pstcDevice->portLatch = portValue;
+            pstcDevice->portLastRead = Pcf8574Sim_GetPins(pstcDevice);
+            UpdateInt(pstcBus);
+        }
+    }
+    pstcBus->u32Bytes += u32Len;
+    pstcDevice->u32Bytes += u32Len;
+}
+
+/**
+ ** \brief Vectored transport of type pfn_pcf8574_i2c_transfer_t, pHandle is the simulated bus
+ **
+ ** All messages are one transaction: repeated start and address byte per
+ ** message, one stop at the end. A NACK stops the transaction.
+ **
+ ** \returns 0 on success, -1 on NACK
+ */
+int Pcf8574Sim_Transfer(void* pHandle, stc_pcf8574_i2c_msg_t* pastcMsgs, uint32_t u32Count)
+{
+    stc_pcf8574_sim_bus_t* pstcBus = (stc_pcf8574_sim_bus_t*)pHandle;
+    stc_pcf8574_sim_device_t* pstcDevice;
+    uint32_t i;
+    pstcBus->u32Transactions++;
+    for(i = 0;i < u32Count;i++)
+    {
+        pstcDevice = BusAddress(pstcBus,pastcMsgs[i].u32Address);
+        if (pstcDevice == NULL)
+        {
+            return -1;
+        }
+        if ((pastcMsgs[i].u16Flags & PCF8574_I2C_M_RD) != 0)
+        {
+            ReadData(pstcBus,pstcDevice,pastcMsgs[i].pu8Data,pastcMsgs[i].u16Len);
+        } else
+        {
+            WriteData(pstcBus,pstcDevice,pastcMsgs[i].pu8Data,pastcMsgs[i].u16Len);
+        }
+    }
+    BusCycles(pstcBus,PCF8574_SIM_STOP_BITS);
+    return 0;
+}
+
+/**
+ *******************************************************************************
+ ** EOF (not truncated)
+ *******************************************************************************
+ */
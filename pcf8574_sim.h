@@ -0,0 +1,209 @@
+/**
+ *******************************************************************************
+ ** Created by the pcf8574 contributors
+ **
+ ** Copyright © 2026 pcf8574 contributors. All rights reserved.
+ **
+ ** 1. Redistributions of source code must retain the above copyright notice,
+ **    this condition and the following disclaimer.
+ **
+ ** This software is provided by the copyright holder and contributors "AS IS"
+ ** and any warranties related to this software are DISCLAIMED.
+ ** The copyright owner or contributors be NOT LIABLE for any damages caused
+ ** by use of this software.
+
+ *******************************************************************************
+ */
+
+/**
+ *******************************************************************************
+ **\file pcf8574_sim.h
+ **
+ ** Simulated PCF8574 / PCF8575 devices and I2C bus for host-side testing
+ ** A detailed description is available at
+ ** @link Pcf8574SimGroup file description @endlink
+ **
+ ** History:
+ ** - 2026-10-16 1.00  First version
+ *******************************************************************************
+ */
+
+#if !defined(__PCF8574_SIM_H__)
+#define __PCF8574_SIM_H__
+
+/* C binding of definitions if building with C++ compiler */
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ *******************************************************************************
+ ** \defgroup Pcf8574SimGroup Simulated PCF8574 devices and I2C bus
+ **
+ ** The simulated bus plugs into pfnRead / pfnWrite of a PCF8574 handle
+ ** (pI2cHandle = pointer of the simulated bus). It models:
+ ** - quasi-bidirectional GPIOs: a GPIO written 0 is driven low, a GPIO
+ **   written 1 is pulled high weakly and follows an external driver
+ ** - INT asserted on any GPIO change against the last read, cleared by
+ **   a read or write of the device
+ ** - several devices sharing one open-drain INT line
+ ** - per-byte bus timing (start, 9 bits per byte, stop), the GPIOs are
+ **   sampled at the acknowledge of every read byte
+ ** - NACKs for unknown addresses and injected NACKs
+ ** - combined transfers (Pcf8574Sim_Transfer) with repeated starts
+ ** - scripted input waveforms with ns timestamps
+ **
+ *******************************************************************************
+ */
+
+//@{
+
+/**
+ *******************************************************************************
+ ** \page pcf8574_sim_example Example of simulator usage
+ ** \brief Following code gives some short example
+ ** @code
+ ** #include "pcf8574_sim.h"
+ **
+ ** stc_pcf8574_sim_bus_t stcSimBus;
+ ** stc_pcf8574_sim_device_t stcSimDevice;
+ ** const stc_pcf8574_sim_step_t astcWave[] =
+ ** {
+ **     { 100000, 0x01, 0x00 },   //100us: drive GPIO0 low
+ **     { 150000, 0x01, 0x01 },   //150us: release GPIO0 (drive high)
+ ** };
+ **
+ ** void SimIntCallback(stc_pcf8574_sim_bus_t* pstcBus)
+ ** {
+ **     Pcf8574_ExtIrqHandle();
+ ** }
+ **
+ **     Pcf8574Sim_InitBus(&stcSimBus,PCF8574_SIM_400KHZ,SimIntCallback);
+ **     Pcf8574Sim_InitDevice(&stcSimBus,&stcSimDevice,0x20,8);
+ **     Pcf8574Sim_SetWaveform(&stcSimDevice,astcWave,2);
+ **     stcPcf8574.pI2cHandle = &stcSimBus;
+ **     stcPcf8574.pfnRead = Pcf8574Sim_Read;
+ **     stcPcf8574.pfnWrite = Pcf8574Sim_Write;
+ **     Pcf8574Sim_Advance(&stcSimBus,1000000);    //run 1ms, calls SimIntCallback on INT
+ ** @endcode
+ **
+ *******************************************************************************
+ */
+
+/**
+ *******************************************************************************
+ ** (Global) Include files
+ *******************************************************************************
+ */
+
+#include "base_types.h"
+#include "pcf8574.h"
+
+/**
+ *******************************************************************************
+ ** Global pre-processor symbols/macros ('#define')
+ *******************************************************************************
+ */
+
+ #define PCF8574_SIM_100KHZ   100000
+ #define PCF8574_SIM_400KHZ   400000
+ #define PCF8574_SIM_1000KHZ  1000000
+
+/**
+ *******************************************************************************
+ ** Global type definitions ('typedef')
+ *******************************************************************************
+ */
+
+/**
+ ** \brief Scripted input step, the external driver changes at u64TimeNs
+ */
+typedef struct stc_pcf8574_sim_step
+{
+    uint64_t u64TimeNs;                ///< bus time of the change
+    pcf8574_port_t portDriveMask;      ///< GPIOs driven externally from now on
+    pcf8574_port_t portDriveValue;     ///< levels of the driven GPIOs
+} stc_pcf8574_sim_step_t;
+
+struct stc_pcf8574_sim_bus;
+
+/**
+ ** \brief INT line callback, called when the shared INT line is asserted
+ */
+typedef void (*pfn_pcf8574_sim_int_t)  (struct stc_pcf8574_sim_bus* pstcBus);
+
+/**
+ ** \brief Simulated PCF8574 / PCF8575 device
+ */
+typedef struct stc_pcf8574_sim_device
+{
+    uint32_t u32Address;
+    uint8_t u8PortBits;                ///< 8 = PCF8574, 16 = PCF8575
+    pcf8574_port_t portLatch;          ///< output latch written by the bus, 1 = weak pull-up
+    pcf8574_port_t portDriveMask;      ///< GPIOs driven by the external driver
+    pcf8574_port_t portDriveValue;     ///< levels of the external driver
+    pcf8574_port_t portLastRead;       ///< GPIO levels at the last read or write, reference for INT
+    boolean_t bInt;                    ///< INT output asserted (low)
+    uint32_t u32NackCount;             ///< next transfers to NACK
+    const stc_pcf8574_sim_step_t* pastcSteps;
+    uint32_t u32StepCount;
+    uint32_t u32StepIndex;
+    uint32_t u32Reads;                 ///< read transactions
+    uint32_t u32Writes;                ///< write transactions
+    uint32_t u32Bytes;                 ///< data bytes transferred
+    uint64_t u64IntTimeNs;             ///< bus time INT was asserted last
+    struct stc_pcf8574_sim_device* Next;
+} stc_pcf8574_sim_device_t;
+
+/**
+ ** \brief Simulated I2C bus with one shared INT line
+ */
+typedef struct stc_pcf8574_sim_bus
+{
+    uint32_t u32BitRate;               ///< SCL frequency in Hz
+    uint64_t u64TimeNs;                ///< bus time
+    stc_pcf8574_sim_device_t* pstcDevices;
+    boolean_t bInt;                    ///< shared INT line asserted (low)
+    pfn_pcf8574_sim_int_t pfnIntCallback;
+    uint32_t u32Transactions;          ///< all transactions including NACKed ones
+    uint32_t u32Bytes;                 ///< all bytes including address bytes
+    uint32_t u32Nacks;
+    uint64_t u64BusyNs;                ///< bus time spent in transactions
+    boolean_t bIntNotified;            ///< INT callback called for the current assertion
+    boolean_t bInCallback;
+} stc_pcf8574_sim_bus_t;
+
+/**
+ *******************************************************************************
+ ** Global function prototypes ('extern', definition in C source)
+ *******************************************************************************
+ */
+
+en_result_t Pcf8574Sim_InitBus(stc_pcf8574_sim_bus_t* pstcBus, uint32_t u32BitRate, pfn_pcf8574_sim_int_t pfnIntCallback);
+en_result_t Pcf8574Sim_InitDevice(stc_pcf8574_sim_bus_t* pstcBus, stc_pcf8574_sim_device_t* pstcDevice, uint32_t u32Address, uint8_t u8PortBits);
+en_result_t Pcf8574Sim_SetWaveform(stc_pcf8574_sim_device_t* pstcDevice, const stc_pcf8574_sim_step_t* pastcSteps, uint32_t u32Count);
+void Pcf8574Sim_Drive(stc_pcf8574_sim_bus_t* pstcBus, stc_pcf8574_sim_device_t* pstcDevice, pcf8574_port_t portDriveMask, pcf8574_port_t portDriveValue);
+void Pcf8574Sim_InjectNack(stc_pcf8574_sim_device_t* pstcDevice, uint32_t u32Count);
+void Pcf8574Sim_Advance(stc_pcf8574_sim_bus_t* pstcBus, uint64_t u64Ns);
+pcf8574_port_t Pcf8574Sim_GetPins(stc_pcf8574_sim_device_t* pstcDevice);
+boolean_t Pcf8574Sim_GetInt(stc_pcf8574_sim_bus_t* pstcBus);
+uint64_t Pcf8574Sim_GetTimeNs(stc_pcf8574_sim_bus_t* pstcBus);
+uint64_t Pcf8574Sim_TransferTimeNs(stc_pcf8574_sim_bus_t* pstcBus, uint32_t u32Len);
+int Pcf8574Sim_Read(void* pHandle, uint32_t u32Address, uint8_t* pu8Data, uint32_t u32Len);
+int Pcf8574Sim_Write(void* pHandle, uint32_t u32Address, uint8_t* pu8Data, uint32_t u32Len);
+int Pcf8574Sim_Transfer(void* pHandle, stc_pcf8574_i2c_msg_t* pastcMsgs, uint32_t u32Count);
+
+//@} // Pcf8574SimGroup
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __PCF8574_SIM_H__ */
+
+/**
+ *******************************************************************************
+ ** EOF (not truncated)
+ *******************************************************************************
+ */